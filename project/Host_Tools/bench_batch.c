@@ -0,0 +1,162 @@
+/**
+ * @file bench_batch.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Compara a fisica em lote (board_batch.c) com board_update() escalar (host)
+ *
+ * Simula as mesmas n bolas pelas duas vias, com rebatidas sorteadas ao longo do
+ * caminho, verifica que os estados finais sao identicos bit a bit e imprime a
+ * vazao de cada uma em bolas atualizadas por segundo.
+ *
+ * Compilacao (a partir de project/Host_Tools):
+ *   gcc -O3 -march=native -ffp-contract=off -I../Project_Headers ../Sources/prng.c ../Sources/board.c ../Sources/board_batch.c bench_batch.c -o bench_batch
+ *
+ * -ffp-contract=off eh necessario para a comparacao bit a bit: sem ele o compilador
+ * pode fundir multiplicacao e soma de formas diferentes nas duas vias. Com
+ * -DBOARD_BATCH_NO_SIMD mede-se o laco escalar usado no alvo.
+ *
+ * Exemplo:
+ *   ./bench_batch -n 4096 -s 2000
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "board.h"
+#include "board_batch.h"
+
+#define HIT_PERIOD 25  // passos entre rodadas de rebatidas sorteadas
+
+static uint32_t bench_rand(uint32_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+static double bench_now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Sorteia as bolas que serao rebatidas no passo k (mesmo sorteio nas duas vias)
+ */
+static int bench_hit(uint32_t seed, uint32_t k, uint32_t i) {
+    uint32_t s = seed ^ (k * 0x9E3779B9u) ^ (i * 0x85EBCA6Bu);
+    if (s == 0) s = 1;
+    return (bench_rand(&s) & 0x7) == 0;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t n = 4096, steps = 2000, dt = 20, seed = 12345, i, k, mismatches = 0;
+    board_t *boards, tmp;
+    prng_t rng;
+    board_batch_t batch;
+    double t0, t_scalar, t_batch;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:d:r:h")) != -1) {
+        switch (opt) {
+            case 'n': n = strtoul(optarg, NULL, 0); break;
+            case 's': steps = strtoul(optarg, NULL, 0); break;
+            case 'd': dt = strtoul(optarg, NULL, 0); break;
+            case 'r': seed = strtoul(optarg, NULL, 0); break;
+            default:
+                fprintf(stderr, "uso: %s [-n bolas] [-s passos] [-d dt_ms] [-r semente]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (n == 0 || seed == 0) {
+        fprintf(stderr, "n e semente devem ser maiores que zero\n");
+        return 1;
+    }
+
+    boards = calloc(n, sizeof(*boards));
+    batch.x = calloc(n, sizeof(float));
+    batch.y = calloc(n, sizeof(float));
+    batch.vx = calloc(n, sizeof(float));
+    batch.vy = calloc(n, sizeof(float));
+    batch.bounces_left = calloc(n, 1);
+    batch.bounces_right = calloc(n, 1);
+    batch.region = calloc(n, 1);
+    batch.n = n;
+    batch.params = &board_default_params;
+    if (boards == NULL || batch.x == NULL || batch.y == NULL || batch.vx == NULL || batch.vy == NULL ||
+        batch.bounces_left == NULL || batch.bounces_right == NULL || batch.region == NULL) {
+        fprintf(stderr, "memoria insuficiente\n");
+        return 1;
+    }
+
+    // lancamentos variados: direcao, altura e velocidade vertical sorteadas
+    prng_seed(&rng, seed);
+    for (i = 0; i < n; i++) {
+        board_reset(&boards[i]);
+        board_reset_ball(&boards[i], &rng);
+        boards[i].ball_pos.y = 4 + prng_range(&rng, 32);
+        boards[i].ball_vel.y = prng_float(&rng, -0.03f, 0.03f);
+        board_batch_set(&batch, i, &boards[i]);
+    }
+
+    t0 = bench_now();
+    for (k = 0; k < steps; k++) {
+        for (i = 0; i < n; i++) {
+            board_update(&boards[i], dt * 1000);
+        }
+        if (k % HIT_PERIOD == 0) {
+            for (i = 0; i < n; i++) {
+                if (bench_hit(seed, k, i)) board_hit_ball(&boards[i]);
+            }
+        }
+    }
+    t_scalar = bench_now() - t0;
+
+    t0 = bench_now();
+    for (k = 0; k < steps; k++) {
+        board_batch_update(&batch, dt * 1000);
+        if (k % HIT_PERIOD == 0) {
+            for (i = 0; i < n; i++) {
+                if (bench_hit(seed, k, i)) {
+                    board_batch_get(&batch, i, &tmp);
+                    board_hit_ball(&tmp);
+                    board_batch_set(&batch, i, &tmp);
+                }
+            }
+        }
+    }
+    t_batch = bench_now() - t0;
+
+    for (i = 0; i < n; i++) {
+        board_batch_get(&batch, i, &tmp);
+        if (memcmp(&tmp.ball_pos, &boards[i].ball_pos, sizeof(tmp.ball_pos)) != 0 ||
+            memcmp(&tmp.ball_vel, &boards[i].ball_vel, sizeof(tmp.ball_vel)) != 0 ||
+            tmp.bounces_left != boards[i].bounces_left || tmp.bounces_right != boards[i].bounces_right ||
+            tmp.region != boards[i].region) {
+            if (mismatches++ < 5) {
+                fprintf(stderr, "bola %u difere: escalar (%a, %a) lote (%a, %a)\n", i, boards[i].ball_pos.x,
+                        boards[i].ball_pos.y, tmp.ball_pos.x, tmp.ball_pos.y);
+            }
+        }
+    }
+
+    printf("%u bolas x %u passos (dt = %u ms)\n", n, steps, dt);
+    printf("  escalar: %.3f s, %.2f M bolas/s\n", t_scalar, (double)n * steps / t_scalar / 1e6);
+    printf("  lote:    %.3f s, %.2f M bolas/s (%.2fx)\n", t_batch, (double)n * steps / t_batch / 1e6, t_scalar / t_batch);
+    printf("  estados finais %s (%u divergentes)\n", mismatches ? "DIFERENTES" : "identicos", mismatches);
+
+    free(boards);
+    free(batch.x);
+    free(batch.y);
+    free(batch.vx);
+    free(batch.vy);
+    free(batch.bounces_left);
+    free(batch.bounces_right);
+    free(batch.region);
+    return mismatches != 0;
+}
@@ -0,0 +1,363 @@
+/**
+ * @file sim_match.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Simulador Monte-Carlo de partidas para ajuste das constantes fisicas (host)
+ *
+ * Roda o nucleo do jogo (board.c) sem perifericos, com dois jogadores simulados,
+ * sobre uma grade de valores de g, v0, coeficiente de restituicao e ganho de
+ * rebatimento. Com -a os dois lados sao o jogador automatico do jogo (ai.c). Para cada ponto da grade imprime a distribuicao do numero de
+ * rebatidas por ponto, os desfechos dos pontos e a distribuicao da velocidade
+ * da bola no momento das rebatidas.
+ *
+ * Compilacao (a partir de project/Host_Tools):
+ *   gcc -O2 -pthread -I../Project_Headers -I. ../Sources/prng.c ../Sources/board.c ../Sources/ai.c work_pool.c sim_match.c -o sim_match -lm
+ *
+ * Exemplo:
+ *   ./sim_match -m 20000 -g 3.5e-5:5.5e-5:3 -e .7:.9:3
+ *   ./sim_match -m 20000 -a 150:60:16
+ *
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ai.h"
+#include "board.h"
+#include "work_pool.h"
+
+#define RALLY_BUCKETS 32   // 0 a 30 rebatidas e ">= 31"
+#define SPEED_BUCKETS 64   // faixas de 2 m/s: 0 a 126 m/s e ">= 126" (hit_mult se acumula a cada rebatida)
+#define SPEED_BUCKET_MPS 2.
+#define POINT_TIMEOUT_MS 60000
+#define GAMES_TO_SET 1     // mesmo valor usado em game_loop()
+
+typedef enum {
+    OUTCOME_DOUBLE_BOUNCE,  // dois quiques do mesmo lado
+    OUTCOME_OUT_DIRECT,     // saiu da quadra sem quicar do outro lado
+    OUTCOME_OUT_BOUNCED,    // quicou uma vez e saiu da quadra
+    OUTCOME_TIMEOUT,        // ponto nao terminou dentro de POINT_TIMEOUT_MS
+    N_OUTCOMES
+} outcome_t;
+
+static const char *outcome_names[N_OUTCOMES] = {"dois_quiques", "fora_direto", "fora_apos_quique", "timeout"};
+
+typedef struct {
+    uint64_t matches;
+    uint64_t points;
+    uint64_t wins[2];
+    uint64_t outcome[N_OUTCOMES];
+    uint64_t rally_hist[RALLY_BUCKETS];
+    uint64_t speed_hist[SPEED_BUCKETS];
+    uint64_t hits;
+    double speed_sum;  // m/s
+} sim_stats_t;
+
+typedef struct {
+    float reach_min;  // distancia minima da linha de fundo onde o jogador rebate (pixels)
+    float reach_max;  // distancia maxima da linha de fundo onde o jogador rebate (pixels)
+    uint32_t dt;      // passo da simulacao (ms)
+    uint8_t sets_to_win;
+    uint8_t use_ai;   // 1: os dois lados sao jogados por ai.c
+    ai_params_t ai;
+} sim_config_t;
+
+typedef struct {
+    board_params_t params;
+    const sim_config_t *config;
+    uint32_t matches;
+    uint64_t seed;
+    sim_stats_t stats;
+} sim_task_t;
+
+/*
+ * Cada tarefa tem o seu proprio gerador (prng.c, o mesmo do jogo), com semente
+ * derivada da semente global e do indice da tarefa, de modo que o resultado nao
+ * depende do escalonamento.
+ */
+static uint64_t sim_splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Distancia da bola ate a linha de fundo do jogador
+ */
+static float sim_dist_to_baseline(const board_t *board, player_t player) {
+    return player == PLAYER_1 ? board->ball_pos.x : SCREEN_WIDTH - board->ball_pos.x;
+}
+
+/**
+ * @brief Simula um ponto, seguindo a mesma sequencia de game_loop()
+ *
+ * @return vencedor do ponto
+ */
+static player_t sim_point(board_t *board, const sim_config_t *cfg, prng_t *rng, sim_stats_t *stats) {
+    player_t turn, winner = PLAYER_NONE;
+    region_t side;
+    float reach = 0, speed;
+    uint8_t armed = 0, press;
+    uint32_t t, hits = 0;
+    outcome_t outcome = OUTCOME_TIMEOUT;
+    ai_t ai[2];
+
+    board_reset_ball(board, rng);
+    turn = board->ball_vel.x > 0 ? PLAYER_2 : PLAYER_1;
+    ai_init(&ai[0], PLAYER_1, &cfg->ai, rng);
+    ai_init(&ai[1], PLAYER_2, &cfg->ai, rng);
+    for (t = 0; t < POINT_TIMEOUT_MS; t += cfg->dt) {
+        board_update(board, cfg->dt * 1000);
+        winner = board_check_winner_point(board);
+        if (winner != PLAYER_NONE) {
+            if (board->bounces_left > 1 || board->bounces_right > 1) {
+                outcome = OUTCOME_DOUBLE_BOUNCE;
+            } else if (board->bounces_left == 1 || board->bounces_right == 1) {
+                outcome = OUTCOME_OUT_BOUNCED;
+            } else {
+                outcome = OUTCOME_OUT_DIRECT;
+            }
+            break;
+        }
+
+        if (cfg->use_ai) {
+            // os dois sao atualizados a cada quadro, como em game_loop()
+            press = ai_update(&ai[0], board, cfg->dt * 1000);
+            press = ai_update(&ai[1], board, cfg->dt * 1000) ? PLAYER_2 : (press ? PLAYER_1 : PLAYER_NONE);
+            press = press == turn;
+        } else {
+            // botao do jogador da vez so e habilitado quando a bola chega ao seu lado
+            side = turn == PLAYER_1 ? LEFT : RIGHT;
+            if (!armed && board->region == side) {
+                armed = 1;
+                reach = prng_float(rng, cfg->reach_min, cfg->reach_max);
+            }
+            press = armed && sim_dist_to_baseline(board, turn) <= reach;
+        }
+        if (press) {
+            speed = sqrtf(board->ball_vel.x * board->ball_vel.x + board->ball_vel.y * board->ball_vel.y);
+            speed = speed * 1000 / PIXELS_P_METER;  // pixels/ms -> m/s
+            board_hit_ball(board);
+            stats->hits++;
+            stats->speed_sum += speed;
+            stats->speed_hist[speed / SPEED_BUCKET_MPS < SPEED_BUCKETS - 1 ? (unsigned)(speed / SPEED_BUCKET_MPS) : SPEED_BUCKETS - 1]++;
+            hits++;
+            armed = 0;
+            turn = turn == PLAYER_1 ? PLAYER_2 : PLAYER_1;
+        }
+    }
+
+    stats->points++;
+    stats->outcome[outcome]++;
+    stats->rally_hist[hits < RALLY_BUCKETS - 1 ? hits : RALLY_BUCKETS - 1]++;
+    if (winner == PLAYER_NONE) {
+        // ponto travado: sorteia para a partida poder terminar
+        winner = prng_range(rng, 2) ? PLAYER_2 : PLAYER_1;
+    }
+    stats->wins[winner - 1]++;
+    return winner;
+}
+
+static void sim_task_run(void *arg, unsigned worker) {
+    sim_task_t *task = arg;
+    board_t board;
+    prng_t rng;
+    uint32_t m;
+    player_t winner;
+    (void)worker;
+
+    prng_seed(&rng, (uint32_t)(task->seed ^ (task->seed >> 32)));
+    for (m = 0; m < task->matches; m++) {
+        board_reset(&board);
+        board.params = &task->params;
+        do {
+            winner = sim_point(&board, task->config, &rng, &task->stats);
+            if (board_score_point(&board, winner)) {
+                board_score_set(&board, GAMES_TO_SET);
+            }
+        } while (board_check_winner_match(&board, task->config->sets_to_win) == PLAYER_NONE);
+        task->stats.matches++;
+    }
+}
+
+static void sim_stats_add(sim_stats_t *acc, const sim_stats_t *s) {
+    int i;
+    acc->matches += s->matches;
+    acc->points += s->points;
+    acc->wins[0] += s->wins[0];
+    acc->wins[1] += s->wins[1];
+    for (i = 0; i < N_OUTCOMES; i++) acc->outcome[i] += s->outcome[i];
+    for (i = 0; i < RALLY_BUCKETS; i++) acc->rally_hist[i] += s->rally_hist[i];
+    for (i = 0; i < SPEED_BUCKETS; i++) acc->speed_hist[i] += s->speed_hist[i];
+    acc->hits += s->hits;
+    acc->speed_sum += s->speed_sum;
+}
+
+static void sim_stats_print(const board_params_t *p, const sim_stats_t *s) {
+    int i;
+    printf("grade g=%g v0=%g restituicao=%g ganho=%g\n", p->g, p->v0, p->restitution, p->hit_mult);
+    printf("  partidas %llu pontos %llu pontos/partida %.2f vitorias_p1 %.4f\n",
+           (unsigned long long)s->matches, (unsigned long long)s->points,
+           s->matches ? (double)s->points / s->matches : 0,
+           s->points ? (double)s->wins[0] / s->points : 0);
+    printf("  desfecho");
+    for (i = 0; i < N_OUTCOMES; i++) {
+        printf(" %s=%.4f", outcome_names[i], s->points ? (double)s->outcome[i] / s->points : 0);
+    }
+    printf("\n  rebatidas/ponto media %.3f:", s->points ? (double)s->hits / s->points : 0);
+    for (i = 0; i < RALLY_BUCKETS; i++) {
+        printf(" %llu", (unsigned long long)s->rally_hist[i]);
+    }
+    printf("\n  velocidade (m/s, faixas de %.1f) media %.3f:", SPEED_BUCKET_MPS, s->hits ? s->speed_sum / s->hits : 0);
+    for (i = 0; i < SPEED_BUCKETS; i++) {
+        printf(" %llu", (unsigned long long)s->speed_hist[i]);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Le uma faixa "min:max:passos" ou um valor unico
+ */
+static int sim_parse_range(const char *arg, float range[3]) {
+    int n = sscanf(arg, "%f:%f:%f", &range[0], &range[1], &range[2]);
+    if (n == 1) {
+        range[1] = range[0];
+        range[2] = 1;
+        return 1;
+    }
+    return n == 3 && range[2] >= 1;
+}
+
+static float sim_range_at(const float range[3], unsigned i) {
+    return range[2] <= 1 ? range[0] : range[0] + (range[1] - range[0]) * i / (range[2] - 1);
+}
+
+static void sim_usage(const char *prog) {
+    fprintf(stderr,
+            "uso: %s [-m partidas] [-c partidas_por_tarefa] [-t threads] [-s semente] [-d dt_ms]\n"
+            "          [-n sets] [-r alcance_min:alcance_max] [-a reacao_ms:erro_ms:alcance]\n"
+            "          [-g faixa] [-v faixa] [-e faixa] [-k faixa]\n"
+            "  faixa = valor ou min:max:passos (g em pixels/ms^2, v0 em pixels/ms)\n",
+            prog);
+}
+
+int main(int argc, char *argv[]) {
+    sim_config_t cfg = {.reach_min = 4, .reach_max = 40, .dt = 20, .sets_to_win = 2, .ai = ai_default_params};
+    float ranges[4][3] = {
+        {G, G, 1},
+        {V0, V0, 1},
+        {RESTITUTION, RESTITUTION, 1},
+        {HIT_MULT, HIT_MULT, 1},
+    };
+    uint32_t matches = 10000, chunk = 64;
+    unsigned threads = 0, n_grid, n_tasks, g, c, i, used;
+    uint64_t seed = 1, seed_state;
+    sim_task_t *tasks;
+    work_item_t *items;
+    work_pool_stats_t *pool_stats;
+    sim_stats_t acc, total;
+    struct timespec t0, t1;
+    double elapsed;
+    int opt, ok = 1;
+
+    while ((opt = getopt(argc, argv, "m:c:t:s:d:n:r:a:g:v:e:k:h")) != -1) {
+        switch (opt) {
+            case 'm': matches = strtoul(optarg, NULL, 0); break;
+            case 'c': chunk = strtoul(optarg, NULL, 0); break;
+            case 't': threads = strtoul(optarg, NULL, 0); break;
+            case 's': seed = strtoull(optarg, NULL, 0); break;
+            case 'd': cfg.dt = strtoul(optarg, NULL, 0); break;
+            case 'n': cfg.sets_to_win = strtoul(optarg, NULL, 0); break;
+            case 'r': ok = sscanf(optarg, "%f:%f", &cfg.reach_min, &cfg.reach_max) == 2; break;
+            case 'a':
+                cfg.use_ai = 1;
+                ok = sscanf(optarg, "%f:%f:%f", &cfg.ai.reaction_ms, &cfg.ai.error_ms, &cfg.ai.reach) == 3;
+                break;
+            case 'g': ok = sim_parse_range(optarg, ranges[0]); break;
+            case 'v': ok = sim_parse_range(optarg, ranges[1]); break;
+            case 'e': ok = sim_parse_range(optarg, ranges[2]); break;
+            case 'k': ok = sim_parse_range(optarg, ranges[3]); break;
+            default: ok = 0; break;
+        }
+        if (!ok) {
+            sim_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (matches == 0 || chunk == 0 || cfg.dt == 0 || cfg.sets_to_win == 0) {
+        sim_usage(argv[0]);
+        return 1;
+    }
+    if (threads == 0) {
+        threads = work_pool_ncpus();
+    }
+
+    // uma tarefa = bloco de ate "chunk" partidas de um ponto da grade
+    n_grid = (unsigned)ranges[0][2] * (unsigned)ranges[1][2] * (unsigned)ranges[2][2] * (unsigned)ranges[3][2];
+    n_tasks = n_grid * ((matches + chunk - 1) / chunk);
+    tasks = calloc(n_tasks, sizeof(*tasks));
+    items = calloc(n_tasks, sizeof(*items));
+    pool_stats = calloc(threads, sizeof(*pool_stats));
+    if (tasks == NULL || items == NULL || pool_stats == NULL) {
+        fprintf(stderr, "memoria insuficiente\n");
+        return 1;
+    }
+    seed_state = seed;
+    for (i = 0, g = 0; g < n_grid; g++) {
+        unsigned k = g;
+        board_params_t p = board_default_params;
+        p.g = sim_range_at(ranges[0], k % (unsigned)ranges[0][2]);
+        k /= (unsigned)ranges[0][2];
+        p.v0 = sim_range_at(ranges[1], k % (unsigned)ranges[1][2]);
+        k /= (unsigned)ranges[1][2];
+        p.restitution = sim_range_at(ranges[2], k % (unsigned)ranges[2][2]);
+        k /= (unsigned)ranges[2][2];
+        p.hit_mult = sim_range_at(ranges[3], k);
+        for (c = 0; c < matches; c += chunk, i++) {
+            tasks[i].params = p;
+            tasks[i].config = &cfg;
+            tasks[i].matches = matches - c < chunk ? matches - c : chunk;
+            tasks[i].seed = sim_splitmix64(&seed_state);
+            items[i].fn = sim_task_run;
+            items[i].arg = &tasks[i];
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    used = work_pool_run(items, n_tasks, threads, pool_stats);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (used == 0) {
+        fprintf(stderr, "falha ao criar o pool de threads\n");
+        return 1;
+    }
+    elapsed = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    // agrega na ordem das tarefas: resultado independe do numero de threads
+    memset(&total, 0, sizeof(total));
+    for (i = 0, g = 0; g < n_grid; g++) {
+        memset(&acc, 0, sizeof(acc));
+        for (c = 0; c < matches; c += chunk, i++) {
+            sim_stats_add(&acc, &tasks[i].stats);
+        }
+        sim_stats_print(&tasks[i - 1].params, &acc);
+        sim_stats_add(&total, &acc);
+    }
+
+    fprintf(stderr, "%u threads, %u tarefas, %.3f s: %.0f pontos/s, %.0f partidas/s\n", used, n_tasks, elapsed,
+            total.points / elapsed, total.matches / elapsed);
+    for (i = 0; i < used; i++) {
+        fprintf(stderr, "  thread %u: %llu tarefas (%llu roubadas)\n", i,
+                (unsigned long long)pool_stats[i].executed, (unsigned long long)pool_stats[i].stolen);
+    }
+
+    free(tasks);
+    free(items);
+    free(pool_stats);
+    return 0;
+}
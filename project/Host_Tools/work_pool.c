@@ -0,0 +1,155 @@
+/**
+ * @file work_pool.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Pool de threads com roubo de trabalho (host)
+ *
+ * As filas sao protegidas por um mutex cada: o custo e desprezivel frente ao
+ * tamanho das tarefas (blocos de partidas simuladas) e nao ha disputa enquanto
+ * cada thread consome a propria fila.
+ *
+ * @date 2026-10-19
+ */
+
+#include "work_pool.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+typedef struct {
+    pthread_mutex_t lock;
+    size_t head;  // proxima tarefa a ser roubada
+    size_t tail;  // uma depois da proxima tarefa do dono
+} work_deque_t;
+
+typedef struct {
+    const work_item_t *items;
+    work_deque_t *deques;
+    unsigned n_workers;
+    atomic_size_t remaining;  // tarefas ainda nao retiradas de nenhuma fila
+} work_pool_t;
+
+typedef struct {
+    work_pool_t *pool;
+    unsigned id;
+    work_pool_stats_t stats;
+} work_thread_t;
+
+static int work_deque_pop(work_deque_t *d, size_t *idx) {
+    int ok = 0;
+    pthread_mutex_lock(&d->lock);
+    if (d->head < d->tail) {
+        *idx = --d->tail;
+        ok = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return ok;
+}
+
+static int work_deque_steal(work_deque_t *d, size_t *idx) {
+    int ok = 0;
+    pthread_mutex_lock(&d->lock);
+    if (d->head < d->tail) {
+        *idx = d->head++;
+        ok = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return ok;
+}
+
+static void *work_thread(void *arg) {
+    work_thread_t *self = arg;
+    work_pool_t *pool = self->pool;
+    unsigned victim, i;
+    size_t idx = 0;
+    uint32_t rnd = 2463534242u ^ (self->id * 0x9E3779B9u);
+
+    while (atomic_load_explicit(&pool->remaining, memory_order_relaxed) > 0) {
+        if (!work_deque_pop(&pool->deques[self->id], &idx)) {
+            // fila propria vazia: tenta roubar a partir de uma vitima aleatoria
+            rnd ^= rnd << 13;
+            rnd ^= rnd >> 17;
+            rnd ^= rnd << 5;
+            victim = rnd % pool->n_workers;
+            for (i = 0; i < pool->n_workers; i++, victim = (victim + 1) % pool->n_workers) {
+                if (victim != self->id && work_deque_steal(&pool->deques[victim], &idx)) {
+                    break;
+                }
+            }
+            if (i == pool->n_workers) {
+                // nada para roubar: as tarefas restantes ja estao em execucao
+                break;
+            }
+            self->stats.stolen++;
+        }
+        atomic_fetch_sub_explicit(&pool->remaining, 1, memory_order_relaxed);
+        pool->items[idx].fn(pool->items[idx].arg, self->id);
+        self->stats.executed++;
+    }
+    return NULL;
+}
+
+unsigned work_pool_ncpus(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (unsigned)n : 1;
+}
+
+unsigned work_pool_run(const work_item_t *items, size_t n, unsigned n_workers, work_pool_stats_t *stats) {
+    work_pool_t pool;
+    work_thread_t *threads;
+    pthread_t *tids;
+    unsigned i, started;
+
+    if (n_workers == 0) {
+        n_workers = work_pool_ncpus();
+    }
+    pool.items = items;
+    pool.n_workers = n_workers;
+    atomic_init(&pool.remaining, n);
+    pool.deques = calloc(n_workers, sizeof(*pool.deques));
+    threads = calloc(n_workers, sizeof(*threads));
+    tids = calloc(n_workers, sizeof(*tids));
+    if (pool.deques == NULL || threads == NULL || tids == NULL) {
+        free(pool.deques);
+        free(threads);
+        free(tids);
+        return 0;
+    }
+
+    // distribui blocos contiguos: o roubo corrige o desbalanceamento
+    for (i = 0; i < n_workers; i++) {
+        pthread_mutex_init(&pool.deques[i].lock, NULL);
+        pool.deques[i].head = n * i / n_workers;
+        pool.deques[i].tail = n * (i + 1) / n_workers;
+        threads[i].pool = &pool;
+        threads[i].id = i;
+    }
+
+    // a thread chamadora faz o papel do worker 0
+    for (started = 1; started < n_workers; started++) {
+        if (pthread_create(&tids[started], NULL, work_thread, &threads[started]) != 0) {
+            break;
+        }
+    }
+    work_thread(&threads[0]);
+    for (i = 1; i < started; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    // caso alguma thread nao tenha sido criada, o worker 0 termina o servico
+    if (atomic_load(&pool.remaining) > 0) {
+        work_thread(&threads[0]);
+    }
+
+    for (i = 0; i < n_workers; i++) {
+        pthread_mutex_destroy(&pool.deques[i].lock);
+        if (stats != NULL) {
+            stats[i] = threads[i].stats;
+        }
+    }
+    free(pool.deques);
+    free(threads);
+    free(tids);
+    return n_workers;
+}
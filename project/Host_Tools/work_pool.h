@@ -0,0 +1,56 @@
+/**
+ * @file work_pool.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos e tipos de dados do pool de threads com roubo de trabalho (host)
+ * @date 2026-10-19
+ */
+
+#ifndef _WORK_POOL_H
+#define _WORK_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Funcao que executa uma tarefa
+ *
+ * @param[in,out] arg argumento da tarefa
+ * @param[in] worker indice da thread que executa a tarefa (0 a n_workers - 1)
+ */
+typedef void (*work_fn_t)(void *arg, unsigned worker);
+
+typedef struct {
+    work_fn_t fn;
+    void *arg;
+} work_item_t;
+
+/**
+ * @brief Estatisticas de uma thread do pool
+ */
+typedef struct {
+    uint64_t executed;  //!< tarefas executadas pela thread
+    uint64_t stolen;    //!< tarefas roubadas de outras threads
+} work_pool_stats_t;
+
+/**
+ * @brief Executa um lote de tarefas em paralelo e retorna quando todas terminarem
+ *
+ * Cada thread comeca com um bloco contiguo de tarefas em sua propria fila dupla:
+ * consome do fim da sua fila e, quando ela esvazia, rouba do inicio da fila de
+ * outra thread.
+ *
+ * @param[in] items tarefas
+ * @param[in] n numero de tarefas
+ * @param[in] n_workers numero de threads (0 usa o numero de nucleos)
+ * @param[out] stats estatisticas por thread (n_workers entradas) ou NULL
+ * @return numero de threads usadas ou 0 em caso de erro
+ */
+unsigned work_pool_run(const work_item_t *items, size_t n, unsigned n_workers, work_pool_stats_t *stats);
+
+/**
+ * @brief Numero de nucleos disponiveis no host
+ */
+unsigned work_pool_ncpus(void);
+
+#endif
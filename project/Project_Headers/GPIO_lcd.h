@@ -1,6 +1,11 @@
 /**
  * @file GPIO_lcd.h
  * @brief Prototipos, macros e tipos de dados de GPIO_lcd
+ *
+ * O barramento do LCD (PTC0-PTC9) eh acessado pelo alias FGPIO no IOPORT, com
+ * acessos de um ciclo. -DLCD_GPIO_PONTE volta ao caminho pela ponte de
+ * perifericos (GPIOC); GPIO_LCD_bench() mede os dois
+ *
  * @author Wu Shin Ting
  * @date 02/02/2024
  */
@@ -10,6 +15,10 @@
 
 #include <stdint.h>
 
+#define LCD_LINHAS 2
+#define LCD_COLUNAS 16
+#define LCD_FILA_LEN 64  // bytes na fila do PIT (potencia de 2); a tela inteira ocupa 34
+
 /**
  * @brief Funcao do byte enviado para LCD
  */
@@ -18,6 +27,41 @@ typedef enum lcd_RS_tag {
     DADO      //!< Dado (1)
 } tipo_lcd_RS;
 
+/**
+ * @brief Caracteres customizados (CGRAM), carregados em GPIO_LCD_init()
+ *
+ * Os codigos 0x08 a 0x0F enderecam os mesmos 8 caracteres que 0x00 a 0x07, mas
+ * podem ser usados dentro de strings terminadas em '\0'
+ */
+typedef enum lcd_glifo_tag {
+    LCD_GLIFO_BOLA = 0x08,  //!< bola (vencedor da partida)
+    LCD_GLIFO_AD,           //!< "AD": vantagem
+    LCD_GLIFO_SAQUE,        //!< seta: jogador que recebe o lancamento
+    LCD_GLIFO_SET,          //!< quadrado cheio: set vencido
+    LCD_GLIFO_FIM
+} tipo_lcd_glifo;
+
+/**
+ * @brief Resultado de GPIO_LCD_bench()
+ */
+typedef struct {
+    uint32_t ciclos_ponte;   //!< ciclos do nucleo por byte pela ponte de perifericos (GPIOC)
+    uint32_t ciclos_ioport;  //!< ciclos do nucleo por byte pelo IOPORT (FGPIOC)
+    uint32_t e_ns;           //!< largura do pulso E no caminho IOPORT
+} GPIO_LCD_bench_t;
+
+#define LCD_N_GLIFOS (LCD_GLIFO_FIM - LCD_GLIFO_BOLA)  // ate 8 (CGRAM de 64 bytes)
+
+/**
+ * @brief Estatisticas da fila de escrita
+ */
+typedef struct {
+    uint8_t depth;      //!< bytes na fila no momento da leitura
+    uint8_t max_depth;  //!< maior ocupacao observada
+    uint32_t bytes;     //!< bytes enviados pelo PIT
+    uint32_t full;      //!< pedidos recusados ou adiados por falta de espaco
+} GPIO_LCD_stats_t;
+
 /*!
  * @brief Habilita conexao entre mcu e LCD.
  */
@@ -38,14 +82,125 @@ void GPIO_LCD_escreve_byte(uint8_t c, uint16_t t);
 
 /*!
  * @brief Inicializa LCD
+ *
+ * Bloqueante: usada antes de o PIT ser habilitado. Carrega os caracteres
+ * customizados (tipo_lcd_glifo) na CGRAM
  */
 void GPIO_LCD_init();
 
+/*!
+ * @brief Prepara a fila de escrita, esvaziada pelo canal 1 do PIT
+ *
+ * Requer PIT_init(). Chamar apos toda troca de perfil de relogio (clock_switch()):
+ * se a fila foi pausada por GPIO_LCD_fila_pausa(), retoma o byte em processamento
+ * com o tempo restante convertido para o novo barramento
+ */
+void GPIO_LCD_fila_init(void);
+
+/*!
+ * @brief Pausa a fila antes de uma troca de perfil de relogio
+ *
+ * O canal 1 conta em ciclos do barramento: sem a pausa, o tempo de processamento
+ * do byte em andamento encolheria ao acelerar o barramento (1530us de Clear
+ * Display virariam ~64us de BLPI para PEE). Guarda o tempo restante em us e para
+ * o canal; nenhum byte eh enviado ate GPIO_LCD_fila_init()
+ */
+void GPIO_LCD_fila_pausa(void);
+
+/*!
+ * @brief Envia o proximo byte da fila (chamada por PIT_IRQHandler ao expirar o canal 1)
+ *
+ * Cada byte eh seguido do tempo de processamento do HD44780: 43us para dados,
+ * 1530us para Clear Display/Return Home e 39us para os demais comandos
+ */
+void GPIO_LCD_fila_isr(void);
+
+/*!
+ * @brief Enfileira um byte sem esperar o LCD
+ * @param[in] c byte
+ * @param[in] rs COMANDO ou DADO
+ * @return 1 se enfileirado, 0 se a fila estiver cheia
+ */
+uint8_t GPIO_LCD_enfileira(uint8_t c, tipo_lcd_RS rs);
+
+/*!
+ * @brief Enfileira uma string a partir de um endereco sem esperar o LCD
+ *
+ * Tudo ou nada: se nao houver espaco para o endereco e todos os caracteres,
+ * nada eh enfileirado. Mantem o espelho da DDRAM coerente
+ *
+ * @param[in] end endereco DDRAM
+ * @param[in] str endereco inicial da string
+ * @return 1 se enfileirada, 0 se a fila nao tiver espaco
+ */
+uint8_t GPIO_LCD_enfileira_string(uint8_t end, const uint8_t *str);
+
+/*!
+ * @brief Indica se a fila terminou de ser enviada
+ * @return 1 se nao ha byte na fila nem em processamento no LCD
+ */
+uint8_t GPIO_LCD_fila_vazia(void);
+
+/*!
+ * @brief Copia as estatisticas da fila de escrita
+ * @param[out] out estatisticas
+ */
+void GPIO_LCD_get_stats(GPIO_LCD_stats_t *out);
+
+/*!
+ * @brief Mostra no LCD as estatisticas da fila de escrita
+ *
+ * Linha 1: ocupacao atual e maior ocupacao. Linha 2: bytes enviados e pedidos
+ * recusados por fila cheia. Escreve no espelho da DDRAM; o LCD muda em
+ * GPIO_LCD_atualiza()
+ */
+void GPIO_LCD_display_stats(void);
+
 /*!
  * @brief Escreve uma string de caracteres a partir de um endereco
+ *
+ * Enfileira com GPIO_LCD_enfileira_string(); so espera se a fila estiver cheia
+ *
  * @param[in] end endereco DDRAM
  * @param[in] str endereco inicial da string
  */
 void GPIO_LCD_escreve_string(uint8_t end, uint8_t *str);
 
+/*!
+ * @brief Escreve uma string no espelho da DDRAM, sem acessar o LCD
+ *
+ * Caracteres fora das LCD_COLUNAS visiveis sao descartados. O LCD so muda em
+ * GPIO_LCD_atualiza()
+ *
+ * @param[in] end endereco DDRAM (0x00 a 0x0F: linha 1; 0x40 a 0x4F: linha 2)
+ * @param[in] str endereco inicial da string
+ */
+void GPIO_LCD_escreve_buffer(uint8_t end, const uint8_t *str);
+
+/*!
+ * @brief Envia ao LCD apenas as celulas do espelho que mudaram
+ *
+ * Celulas alteradas adjacentes sao enviadas com um unico comando "Set DDRAM
+ * Address"; o endereco so eh enviado quando o cursor do LCD nao esta na celula.
+ * Os bytes sao enfileirados; se a fila encher, as celulas restantes continuam
+ * pendentes e sao enviadas na proxima chamada
+ *
+ * @return numero de bytes enfileirados (comandos + dados)
+ */
+uint8_t GPIO_LCD_atualiza(void);
+
+/*!
+ * @brief Mede o custo de colocar um byte no barramento por cada caminho
+ *
+ * Espera a fila esvaziar. Os ciclos nao incluem o tempo de processamento do LCD
+ *
+ * @param[out] out ciclos por byte de cada caminho e largura do pulso E
+ */
+void GPIO_LCD_bench(GPIO_LCD_bench_t *out);
+
+/*!
+ * @brief Executa GPIO_LCD_bench() e mostra o resultado no LCD
+ */
+void GPIO_LCD_bench_run(void);
+
 #endif /* GPIO_LATCH_LCD_H_ */
@@ -15,7 +15,8 @@
 /**
  * @brief Inicializa botoeiras
  *
- * NAO habilita interrupcoes
+ * Habilita as interrupcoes de PTA4, PTA5 e PTA12 nas duas bordas (BTN_IRQC), com
+ * o filtro passivo de entrada ligado
  *
  * @param[in] prioridade prioridade de atendimento
  */
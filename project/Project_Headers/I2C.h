@@ -31,6 +31,13 @@
  * @param[in] icr SCL clock rate
  */
 uint8_t I2C_Init(uint8_t x, uint8_t alt, uint8_t mult, uint8_t icr);
+/**
+ * @brief changes the SCL clock rate (e.g. after a bus clock change)
+ * @param[in] x I2Cx module
+ * @param[in] mult multiplier factor for SCL divider
+ * @param[in] icr SCL clock rate
+ */
+void I2C_SetBaud(uint8_t x, uint8_t mult, uint8_t icr);
 /**
  * @brief sets START condition (changes to Transmit and Master modes)
  * @param[in] x I2Cx module
@@ -76,8 +76,9 @@ typedef enum control_byte_tag {
 
 /**
  * @brief Initialize I2C connection to OLED via PORTB0 and PORTB1
+ * @param[in] icr SCL divider for the current bus clock (clock_get()->i2c_icr)
  */
-void I2C_initConSSD1306(void);
+void I2C_initConSSD1306(uint8_t icr);
 /**
  * @brief Initialize OLED display according to the commands described in
  * https://www.instructables.com/Getting-Started-With-OLED-Displays/
@@ -14,30 +14,6 @@
 
 #include "game.h"
 
-typedef enum {
-    PREPARA_INICIO,
-    INICIO,
-    LAUNCH_BALL,
-    PLAYER_TURN,
-    LCD_UPDATE,
-    WIN_SCREEN,
-    WIN_VISU
-} state_t;
-
-/**
- * @brief Muda o estado do programa
- *
- * @param[in] s novo estado
- */
-void ISR_setState(state_t s);
-
-/**
- * @brief Retorna estado atual do programa
- *
- * @return estado atual
- */
-state_t ISR_getState(void);
-
 /**
  * @brief Atualiza jogador atual
  *
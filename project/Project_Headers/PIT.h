@@ -0,0 +1,55 @@
+/**
+ * @file PIT.h
+ * @brief Prototipos, macros e tipos de dados referentes ao PIT
+ *
+ * Os dois canais do PIT contam o relogio do barramento e compartilham a IRQ 22
+ * (PIT_IRQHandler), que deve verificar a flag de cada canal.
+ *
+ * @date 2026-10-19
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ */
+
+#ifndef PIT_H_
+#define PIT_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Habilita o relogio do PIT e configura a IRQ 22 no NVIC
+ * @param[in] prioridade prioridade da interrupcao (0 a 3)
+ */
+void PIT_init(uint8_t prioridade);
+/**
+ * @brief Ativa um canal com interrupcao periodica
+ * @param[in] canal canal do PIT (0 ou 1)
+ * @param[in] periodo ciclos do barramento entre interrupcoes
+ */
+void PIT_ativa(uint8_t canal, uint32_t periodo);
+/**
+ * @brief Desativa um canal
+ * @param[in] canal canal do PIT (0 ou 1)
+ */
+void PIT_desativa(uint8_t canal);
+/**
+ * @brief Ativa um canal contando livremente, sem interrupcao
+ *
+ * Usado para medir intervalos com PIT_leContagem()
+ *
+ * @param[in] canal canal do PIT (0 ou 1)
+ */
+void PIT_ativaLivre(uint8_t canal);
+/**
+ * @brief Le o contador de um canal
+ * @param[in] canal canal do PIT (0 ou 1)
+ * @return contagem atual (decrescente, em ciclos do barramento)
+ */
+uint32_t PIT_leContagem(uint8_t canal);
+/**
+ * @brief Verifica e limpa a flag de interrupcao de um canal
+ * @param[in] canal canal do PIT (0 ou 1)
+ * @return 1 se o canal expirou desde a ultima verificacao, 0 caso contrario
+ */
+uint8_t PIT_limpaFlag(uint8_t canal);
+
+#endif /* PIT_H_ */
@@ -10,6 +10,10 @@
 
 #include <stdint.h>
 
+#define SIM_IRC_SLOW 32768    // IRC lento (Hz), referencia do FLL no modo FEI
+#define SIM_IRC_FAST 4000000  // IRC rapido (Hz)
+#define SIM_OSC_FREQ 8000000  // cristal da FRDM-KL25Z (Hz)
+
 /*!
  * @brief Seta o divisor de frequencia para sinal de barramento e de Flash
  * @param[in] OUTDIV4 divisor do sinal MCGOUTCLK
@@ -29,4 +33,19 @@ void SIM_setaFLLPLL(uint8_t pll);
  */
 void SIM_setaTPMSRC(uint8_t src);
 
+/*!
+ * @brief Calcula a frequencia do nucleo a partir da configuracao atual do MCG e de OUTDIV1
+ *
+ * Considera os IRCs e o cristal em seus valores nominais
+ *
+ * @return frequencia do nucleo (Hz)
+ */
+uint32_t SIM_leCoreClock(void);
+
+/*!
+ * @brief Calcula a frequencia do barramento (nucleo / (OUTDIV4 + 1))
+ * @return frequencia do barramento (Hz)
+ */
+uint32_t SIM_leBusClock(void);
+
 #endif /* SIM_H_ */
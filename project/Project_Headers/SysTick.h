@@ -0,0 +1,53 @@
+/**
+ * @file SysTick.h
+ * @brief Prototipos, macros e tipos de dados referentes ao SysTick
+ *
+ * O SysTick conta ciclos do nucleo em 24 bits; a cada estouro a ISR incrementa
+ * um contador de 64 bits, formando uma base de tempo monotonica que nao da a
+ * volta na pratica. Reconfigurar o SysTick (troca de relogio) nao zera a
+ * contagem: os ciclos seguintes sao somados aos ja contados, cada trecho na
+ * frequencia do nucleo em que correu.
+ *
+ * @date 2026-10-19
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ */
+
+#ifndef SYSTICK_H_
+#define SYSTICK_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Configura o SysTick com o relogio do nucleo e interrupcao a cada estouro
+ *
+ * Chamar com as interrupcoes desabilitadas se o SysTick ja estiver em uso
+ *
+ * @param[in] period ciclos do nucleo entre interrupcoes (ate 2^24)
+ * @param[in] prioridade prioridade da interrupcao (0 a 3)
+ */
+void SysTick_init(uint32_t period, uint8_t prioridade);
+/**
+ * @brief Contabiliza um estouro do SysTick (chamada por SysTick_Handler)
+ */
+void SysTick_tick(void);
+/**
+ * @brief Le o numero de ciclos do nucleo desde o primeiro SysTick_init()
+ *
+ * Pode ser chamada de qualquer ISR, inclusive com prioridade maior que a do
+ * SysTick: um estouro ainda nao atendido eh detectado pelo bit PENDSTSET
+ *
+ * @return ciclos do nucleo
+ */
+uint64_t SysTick_getCycles(void);
+/**
+ * @brief Le os 32 bits menos significativos de SysTick_getCycles() sem desabilitar interrupcoes
+ *
+ * Repete a leitura se o SysTick_Handler rodar no meio dela; serve para marcar
+ * tempo em ISRs curtas e para diferencas de ate 2^32 ciclos
+ *
+ * @return ciclos do nucleo (modulo 2^32)
+ */
+uint32_t SysTick_getCycles32(void);
+
+#endif /* SYSTICK_H_ */
@@ -0,0 +1,124 @@
+/**
+ * @file ai.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos e tipos de dados do jogador controlado pelo microcontrolador
+ *
+ * A previsao da trajetoria eh analitica (parabola entre quiques, com a perda de
+ * velocidade de cada quique), sem simular passo a passo: para AI_CANDIDATES
+ * instantes de rebatida calcula-se em forma fechada onde a bola devolvida passa
+ * pela rede e onde quica, o que custa AI_CANDIDATES + 1 raizes quadradas. A
+ * previsao eh feita uma vez por passagem da bola, ao fim do tempo de reacao; nos
+ * quadros seguintes ai_update() apenas desconta o tempo. Nao depende de
+ * perifericos, de modo que tambem eh usado pelas ferramentas do host.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _AI_H
+#define _AI_H
+
+#include <stdint.h>
+
+#include "board.h"
+#include "prng.h"
+
+// parametros padrao do jogador automatico
+#define AI_REACTION_MS 150  // atraso entre a bola entrar no seu lado e o inicio da previsao
+#define AI_ERROR_MS 60      // erro maximo (+-) no instante do rebatimento
+#define AI_REACH 16         // distancia da linha de fundo onde prefere rebater (pixels)
+#define AI_CANDIDATES 8     // instantes de rebatida avaliados por previsao
+#define AI_NET_MARGIN 2     // folga minima da bola devolvida sobre a rede (pixels)
+
+/**
+ * @brief Parametros de dificuldade do jogador automatico
+ */
+typedef struct {
+    float reaction_ms;  //!< atraso de reacao (ms)
+    float error_ms;     //!< erro maximo, sorteado uniformemente em +-error_ms a cada bola (ms)
+    float reach;        //!< distancia da linha de fundo onde prefere rebater (pixels)
+} ai_params_t;
+
+/**
+ * @brief Previsao da chegada da bola ao lado de um jogador
+ *
+ * Tempos em ms a partir do estado atual da bola
+ */
+typedef struct {
+    float t_reach;       //!< instante em que a bola chega a distancia reach da linha de fundo
+    float t_deadline;    //!< ultimo instante para rebater (segundo quique ou saida pela linha de fundo)
+    float t_hit;         //!< instante escolhido para rebater
+    float t_safe_first;  //!< primeiro candidato seguro (valido se safe)
+    float t_safe_last;   //!< ultimo candidato seguro (valido se safe)
+    float x_landing;     //!< posicao horizontal do proximo quique
+    uint8_t out;         //!< 1 se a bola sai da quadra sem quicar do lado do jogador
+    uint8_t safe;        //!< 1 se rebater em t_hit devolve a bola por cima da rede e dentro da quadra
+} ai_prediction_t;
+
+typedef enum {
+    AI_WAITING,   //!< bola fora do seu lado
+    AI_REACTING,  //!< bola no seu lado: dentro do tempo de reacao
+    AI_TRACKING,  //!< bola no seu lado: descontando o tempo ate a rebatida prevista
+    AI_DONE       //!< ja rebateu (ou desistiu) nesta passagem da bola
+} ai_state_t;
+
+typedef struct {
+    player_t player;
+    const ai_params_t *params;
+    prng_t *rng;
+    ai_state_t state;
+    float elapsed;    //!< tempo desde que a bola entrou no seu lado (ms)
+    float error;      //!< erro sorteado para esta bola (ms)
+    float countdown;  //!< tempo restante ate a rebatida prevista, ja com o erro (ms)
+    float dt;         //!< ultimo passo de tempo, usado como estimativa do proximo (ms)
+} ai_t;
+
+/**
+ * @brief Parametros padrao do jogador automatico
+ */
+extern const ai_params_t ai_default_params;
+
+/**
+ * @brief Inicializa um jogador automatico
+ *
+ * @param[out] ai estado do jogador automatico
+ * @param[in] player lado controlado (PLAYER_1 a esquerda, PLAYER_2 a direita)
+ * @param[in] params parametros de dificuldade
+ * @param[in,out] rng gerador usado para sortear o erro de cada rebatida
+ */
+void ai_init(ai_t *ai, player_t player, const ai_params_t *params, prng_t *rng);
+/**
+ * @brief Prepara o jogador automatico para um novo ponto
+ *
+ * @param[in,out] ai estado do jogador automatico
+ */
+void ai_reset(ai_t *ai);
+/**
+ * @brief Preve quando a bola chega a zona de rebatida do jogador
+ *
+ * Considera apenas gravidade e quiques no chao (a bola ja passou da rede). Entre
+ * os instantes candidatos ate t_deadline, escolhe o mais proximo de t_reach em que
+ * a bola devolvida passa por cima da rede e quica dentro da quadra adversaria
+ *
+ * @param[in] board estrutura do estado da partida
+ * @param[in] player jogador que vai rebater
+ * @param[in] reach distancia da linha de fundo onde o jogador quer rebater (pixels)
+ * @param[out] pred previsao
+ * @return 1 se a bola se aproxima da linha de fundo do jogador, 0 caso contrario
+ */
+uint8_t ai_predict(const board_t *board, player_t player, float reach, ai_prediction_t *pred);
+/**
+ * @brief Atualiza o jogador automatico e decide se ele rebate agora
+ *
+ * Deve ser chamada a cada quadro, depois de board_update(), mesmo quando nao for a
+ * vez do jogador (o estado eh reiniciado quando a bola sai do seu lado). A
+ * rebatida em si (board_hit_ball()) fica a cargo de quem chama
+ *
+ * @param[in,out] ai estado do jogador automatico
+ * @param[in] board estrutura do estado da partida
+ * @param[in] dt diferenca de tempo em microssegundos desde a ultima chamada
+ * @return 1 se o jogador "apertou o botao", 0 caso contrario
+ */
+uint8_t ai_update(ai_t *ai, const board_t *board, uint32_t dt);
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file bme.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Acessos decorados do Bit Manipulation Engine (BME) aos registradores de perifericos
+ *
+ * O BME executa a leitura-modificacao-escrita dentro da ponte de perifericos, numa
+ * unica operacao de barramento: nao pode ser interrompida por uma ISR que altere
+ * o mesmo registrador, sem secao critica. O endereco do registrador eh "decorado"
+ * com a operacao desejada (Capitulo 17 do Manual):
+ *
+ * - AND, OR e XOR usam os bits 19:0 do endereco: perifericos em 0x4000_0000 a
+ *   0x400F_FFFF, incluindo o GPIO (nao o alias FGPIO do IOPORT);
+ * - BFI e UBFX usam os bits 18:0: apenas 0x4000_0000 a 0x4007_FFFF (PORT, SIM,
+ *   TPM, I2C, ...).
+ *
+ * A largura do acesso (8 ou 32 bits) deve ser a do registrador. Como na escrita
+ * comum, bits "w1c" lidos em 1 sao escritos de volta e limpam a flag.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _BME_H
+#define _BME_H
+
+#include <stdint.h>
+
+#define BME_AND 0x44000000u
+#define BME_OR 0x48000000u
+#define BME_XOR 0x4C000000u
+#define BME_BF 0x50000000u  // BFI na escrita, UBFX na leitura
+
+/**
+ * @brief Endereco decorado para AND/OR/XOR
+ */
+#define BME_OP_ADDR(op, reg) ((op) | ((uint32_t)(uintptr_t)(reg) & 0xFFFFFu))
+/**
+ * @brief Endereco decorado para BFI/UBFX do campo de "width" bits a partir do bit "bit"
+ */
+#define BME_BF_ADDR(reg, bit, width) \
+    (BME_BF | ((uint32_t)(bit) << 23) | ((uint32_t)((width) - 1) << 19) | ((uint32_t)(uintptr_t)(reg) & 0x7FFFFu))
+
+/**
+ * @brief *reg &= mask, atomico
+ */
+static inline void bme_and32(volatile uint32_t *reg, uint32_t mask) {
+    *(volatile uint32_t *)(uintptr_t)BME_OP_ADDR(BME_AND, reg) = mask;
+}
+/**
+ * @brief *reg |= mask, atomico
+ */
+static inline void bme_or32(volatile uint32_t *reg, uint32_t mask) {
+    *(volatile uint32_t *)(uintptr_t)BME_OP_ADDR(BME_OR, reg) = mask;
+}
+/**
+ * @brief *reg ^= mask, atomico
+ */
+static inline void bme_xor32(volatile uint32_t *reg, uint32_t mask) {
+    *(volatile uint32_t *)(uintptr_t)BME_OP_ADDR(BME_XOR, reg) = mask;
+}
+/**
+ * @brief Escreve value no campo de width bits (1 a 16) a partir de bit, atomico
+ *
+ * @param[in] reg registrador em 0x4000_0000 a 0x4007_FFFF
+ * @param[in] bit posicao do bit menos significativo do campo
+ * @param[in] width largura do campo
+ * @param[in] value valor do campo (nao deslocado)
+ */
+static inline void bme_bfi32(volatile uint32_t *reg, uint8_t bit, uint8_t width, uint32_t value) {
+    *(volatile uint32_t *)(uintptr_t)BME_BF_ADDR(reg, bit, width) = value << bit;
+}
+/**
+ * @brief Le o campo de width bits (1 a 16) a partir de bit, ja deslocado
+ */
+static inline uint32_t bme_ubfx32(volatile uint32_t *reg, uint8_t bit, uint8_t width) {
+    return *(volatile uint32_t *)(uintptr_t)BME_BF_ADDR(reg, bit, width);
+}
+
+/**
+ * @brief *reg &= mask, atomico (registrador de 8 bits)
+ */
+static inline void bme_and8(volatile uint8_t *reg, uint8_t mask) {
+    *(volatile uint8_t *)(uintptr_t)BME_OP_ADDR(BME_AND, reg) = mask;
+}
+/**
+ * @brief *reg |= mask, atomico (registrador de 8 bits)
+ */
+static inline void bme_or8(volatile uint8_t *reg, uint8_t mask) {
+    *(volatile uint8_t *)(uintptr_t)BME_OP_ADDR(BME_OR, reg) = mask;
+}
+/**
+ * @brief *reg ^= mask, atomico (registrador de 8 bits)
+ */
+static inline void bme_xor8(volatile uint8_t *reg, uint8_t mask) {
+    *(volatile uint8_t *)(uintptr_t)BME_OP_ADDR(BME_XOR, reg) = mask;
+}
+/**
+ * @brief Escreve value no campo de width bits a partir de bit, atomico (registrador de 8 bits)
+ */
+static inline void bme_bfi8(volatile uint8_t *reg, uint8_t bit, uint8_t width, uint8_t value) {
+    *(volatile uint8_t *)(uintptr_t)BME_BF_ADDR(reg, bit, width) = (uint8_t)(value << bit);
+}
+
+#endif
@@ -0,0 +1,161 @@
+/**
+ * @file board.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos, macros e tipos de dados do nucleo do jogo (fisica e placar)
+ *
+ * Este modulo nao depende de nenhum periferico do microcontrolador, de modo que
+ * pode ser compilado tanto para o alvo quanto para as ferramentas do host.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _BOARD_H
+#define _BOARD_H
+
+#include <stdint.h>
+
+#include "prng.h"
+
+// dimensoes da tela (quadra)
+#define SCREEN_WIDTH 128
+#define SCREEN_HEIGHT 64
+
+// dimensoes da quadra
+#define NET_TOP SCREEN_HEIGHT - 24
+#define NET_LEFT SCREEN_WIDTH / 2 - 1
+#define NET_RIGHT SCREEN_WIDTH / 2 + 1
+#define FLOOR_LEVEL SCREEN_HEIGHT - 6
+#define FLOOR_HEIGHT 2
+
+// constantes fisicas padrao
+#define PIXELS_P_METER 4.712                   // 112 pixels / 23.77 m
+#define G 9.81 * PIXELS_P_METER / 1000 / 1000  // pixels / ms^2
+#define V0 5 * PIXELS_P_METER / 1000           // pixels / ms
+#define RESTITUTION .8                         // fracao da velocidade mantida ao quicar
+#define HIT_MULT 1.1                           // ganho de velocidade no rebatimento
+#define SERVE_SPREAD .2                        // variacao relativa maxima de v0 no lancamento
+#define SERVE_VY 2 * PIXELS_P_METER / 1000     // velocidade vertical maxima no lancamento (pixels / ms)
+
+#define SCORE_AD 41  // score_t.points: vantagem apos 40 iguais
+
+typedef enum {
+    PLAYER_NONE,
+    PLAYER_1,
+    PLAYER_2
+} player_t;
+
+typedef enum {
+    LEFT,
+    MIDDLE,
+    RIGHT
+} region_t;
+
+typedef struct {
+    float x;
+    float y;
+} vector_2d_t;
+
+typedef struct {
+    uint8_t sets;
+    uint8_t games;
+    uint8_t points;
+} score_t;
+
+/**
+ * @brief Constantes fisicas usadas pela simulacao
+ */
+typedef struct {
+    float g;            //!< aceleracao da gravidade (pixels / ms^2)
+    float v0;           //!< velocidade horizontal de lancamento (pixels / ms)
+    float restitution;  //!< fracao da velocidade mantida ao quicar no chao ou na rede
+    float hit_mult;     //!< ganho de velocidade no rebatimento
+    float serve_spread; //!< variacao relativa maxima da velocidade horizontal no lancamento
+    float serve_vy;     //!< modulo maximo da velocidade vertical no lancamento (pixels / ms)
+} board_params_t;
+
+typedef struct {
+    vector_2d_t ball_pos;
+    vector_2d_t ball_vel;
+    score_t score[2];
+    uint8_t bounces_left;
+    uint8_t bounces_right;
+    region_t region;               //!< ultima regiao em que a bola foi vista acima da rede
+    const board_params_t *params;  //!< constantes fisicas da partida
+} board_t;
+
+/**
+ * @brief Constantes fisicas usadas no jogo
+ */
+extern const board_params_t board_default_params;
+
+/**
+ * @brief Reinicia a partida
+ *
+ * Usa as constantes fisicas padrao (board_default_params)
+ *
+ * @param[in,out] board estrutura do estado da partida
+ */
+void board_reset(board_t *board);
+/**
+ * @brief Atualiza o estado da partida
+ *
+ * Faz os calculos da fisica dos elementos do jogo. Quando a bola passa por cima da
+ * rede de um lado para o outro, board->region eh atualizado
+ *
+ * @param[in,out] board estrutura do estado da partida
+ * @param[in] dt_us diferenca de tempo em microssegundos desde a ultima execucao
+ */
+void board_update(board_t *board, uint32_t dt_us);
+/**
+ * @brief Verifica se algum jogador venceu o ponto
+ *
+ * @param[in,out] board estrutura do estado da partida
+ * @return jogador que venceu o ponto atual ou PLAYER_NONE caso nao haja vencedor
+ */
+player_t board_check_winner_point(board_t *board);
+/**
+ * @brief Verifica se algum jogador venceu a partida
+ *
+ * @param[in,out] board estrutura do estado da partida
+ * @param[in] sets_to_win
+ * @return jogador que venceu a partida ou PLAYER_NONE caso nao haja vencedor
+ */
+player_t board_check_winner_match(board_t *board, uint8_t sets_to_win);
+/**
+ * @brief Reposiciona a bola no meio da quadra e da uma velocidade inicial aleatoria
+ *
+ * Sorteia o lado para o qual a bola eh lancada, a velocidade horizontal em
+ * v0 * (1 +- serve_spread) e a vertical em +- serve_vy
+ *
+ * @param[in,out] board estrutura do estado da partida
+ * @param[in,out] rng gerador de numeros pseudo-aleatorios
+ */
+void board_reset_ball(board_t *board, prng_t *rng);
+/**
+ * @brief Registra um rebatimento da bola e atualiza sua velocidade
+ *
+ * @param[in,out] board estrutura do estado da partida
+ */
+void board_hit_ball(board_t *board);
+/**
+ * @brief Contabiliza um ponto para o vencedor
+ *
+ * Com 40 iguais (deuce), o ponto da SCORE_AD ao vencedor; se o adversario
+ * estava em vantagem, os dois voltam a 40
+ *
+ * @param[in,out] board estrutura do estado da partida
+ * @param[in] winner vencedor do ponto
+ * @return 1 se o ponto fechou um game, 0 caso contrario
+ */
+uint8_t board_score_point(board_t *board, player_t winner);
+/**
+ * @brief Fecha o set caso algum jogador tenha atingido o numero de games necessario
+ *
+ * @param[in,out] board estrutura do estado da partida
+ * @param[in] games_to_set quantos games necessarios para vencer set
+ * @return 1 se o set foi fechado, 0 caso contrario
+ */
+uint8_t board_score_set(board_t *board, uint8_t games_to_set);
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @file board_batch.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos e tipos de dados da fisica em lote (varias bolas independentes)
+ *
+ * Forma "estrutura de vetores" do passo de board_update(): cada campo da bola fica
+ * num vetor proprio, de modo que o laco de atualizacao nao tem desvios e pode ser
+ * vetorizado pelo compilador no host. O resultado de cada bola e identico, bit a
+ * bit, ao de board_update() desde que ambos sejam compilados sem contracao de
+ * multiplicacao e soma (-ffp-contract=off).
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _BOARD_BATCH_H
+#define _BOARD_BATCH_H
+
+#include <stdint.h>
+
+#include "board.h"
+
+/**
+ * @brief Estado de n bolas independentes
+ *
+ * Os vetores sao alocados por quem usa o lote e devem ter ao menos n posicoes.
+ * region guarda valores de region_t.
+ */
+typedef struct {
+    float *x;
+    float *y;
+    float *vx;
+    float *vy;
+    uint8_t *bounces_left;
+    uint8_t *bounces_right;
+    uint8_t *region;
+    uint32_t n;
+    const board_params_t *params;
+} board_batch_t;
+
+/**
+ * @brief Atualiza todas as bolas do lote
+ *
+ * Equivalente a chamar board_update() para cada bola
+ *
+ * @param[in,out] batch lote de bolas
+ * @param[in] dt diferenca de tempo em microssegundos desde a ultima execucao
+ */
+void board_batch_update(board_batch_t *batch, uint32_t dt);
+/**
+ * @brief Copia a bola i do lote para uma estrutura board_t
+ *
+ * O placar de board nao eh alterado
+ *
+ * @param[in] batch lote de bolas
+ * @param[in] i indice da bola
+ * @param[out] board estrutura do estado da partida
+ */
+void board_batch_get(const board_batch_t *batch, uint32_t i, board_t *board);
+/**
+ * @brief Copia a bola de uma estrutura board_t para a posicao i do lote
+ *
+ * @param[in,out] batch lote de bolas
+ * @param[in] i indice da bola
+ * @param[in] board estrutura do estado da partida
+ */
+void board_batch_set(board_batch_t *batch, uint32_t i, const board_t *board);
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file clock.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos, macros e tipos de dados dos perfis de relogio
+ *
+ * Cada perfil descreve um modo do MCG e os divisores do SIM junto com as
+ * frequencias resultantes e os parametros de perifericos que dependem delas.
+ * Todo codigo que converte tempo em ciclos deve usar clock_get() em vez de
+ * constantes.
+ *
+ * clock_init() apenas leva o MCG ao perfil (usada por config()); clock_switch()
+ * troca o perfil com o sistema em funcionamento e re-deriva SysTick, base de
+ * tempo, atrasos e I2C, medindo a duracao da troca.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _CLOCK_H
+#define _CLOCK_H
+
+#include <stdint.h>
+
+typedef enum {
+    CLOCK_FEI_21MHZ,  //!< FLL com IRC lento: nucleo 20,97 MHz, barramento 10,49 MHz
+    CLOCK_PEE_48MHZ,  //!< PLL com cristal de 8 MHz: nucleo 48 MHz, barramento 24 MHz
+    CLOCK_BLPI_4MHZ,  //!< IRC rapido com FLL desligado, em VLPR: nucleo 4 MHz, barramento 1 MHz
+    CLOCK_N_PROFILES
+} clock_id_t;
+
+// perfil usado por config(): -DCLOCK_PROFILE=CLOCK_FEI_21MHZ para o relogio original
+#ifndef CLOCK_PROFILE
+#define CLOCK_PROFILE CLOCK_PEE_48MHZ
+#endif
+
+/**
+ * @brief Frequencias e parametros derivados de um perfil
+ */
+typedef struct {
+    uint32_t core;     //!< nucleo e SysTick (Hz)
+    uint32_t bus;      //!< barramento, flash, PIT e I2C (Hz)
+    uint32_t tpm;      //!< TPM com TPMSRC = 01: MCGFLLCLK ou MCGPLLCLK/2 (Hz); 0 se parado
+    uint8_t outdiv1;   //!< divisor do nucleo - 1
+    uint8_t outdiv4;   //!< divisor do barramento - 1
+    uint8_t i2c_icr;   //!< divisor de SCL do I2C0 (Tabela 38-41 do Manual)
+    uint8_t vlpr;      //!< 1: executa em VLPR (SMC)
+} clock_profile_t;
+
+/**
+ * @brief Estatisticas de clock_switch()
+ */
+typedef struct {
+    uint32_t switches;  //!< trocas de perfil
+    uint32_t last_us;   //!< duracao da ultima troca
+    uint32_t max_us;    //!< maior duracao
+} clock_stats_t;
+
+/**
+ * @brief Leva o MCG e o SIM ao perfil pedido
+ *
+ * Bloqueia ate o oscilador e o PLL estabilizarem. Nao altera perifericos
+ *
+ * @param[in] id perfil
+ */
+void clock_init(clock_id_t id);
+/**
+ * @brief Troca o perfil com o sistema em funcionamento
+ *
+ * Depois da troca reconfigura o SysTick mantendo a base de tempo continua,
+ * recalibra delay.c e ajusta o divisor do I2C0. A contagem de ciclos do
+ * SysTick continua (SysTick.h) e os atrasos nao bloqueantes (delay_t) seguem
+ * validos. Chamar fora de ISRs, sem transferencia I2C em andamento
+ *
+ * @param[in] id perfil
+ */
+void clock_switch(clock_id_t id);
+/**
+ * @brief Perfil em uso
+ *
+ * @return frequencias e parametros do perfil
+ */
+const clock_profile_t *clock_get(void);
+/**
+ * @brief Copia as estatisticas de troca de perfil
+ *
+ * @param[out] stats estatisticas
+ */
+void clock_get_stats(clock_stats_t *stats);
+/**
+ * @brief Mostra no LCD as estatisticas de troca de perfil
+ *
+ * Linha 1: numero de trocas. Linha 2: duracao da ultima troca e a maior, em us.
+ * Escreve no espelho da DDRAM; o LCD muda em GPIO_LCD_atualiza()
+ */
+void clock_display_LCD(void);
+
+#endif
@@ -0,0 +1,102 @@
+/**
+ * @file delay.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos e tipos de dados do servico de atrasos
+ *
+ * Atrasos medidos em ciclos do SysTick (relogio do nucleo). delay_init() le a
+ * frequencia realmente configurada (SIM_leCoreClock()), de modo que mudar o
+ * FLL/PLL ou os divisores nao altera a duracao dos atrasos.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _DELAY_H
+#define _DELAY_H
+
+#include <stdint.h>
+
+#include "swtimer.h"
+
+#define DELAY_TEST_N 4         // duracoes medidas por delay_selftest()
+#define DELAY_TEST_LPO_MS 1000  // duracao comparada com o LPO
+
+/**
+ * @brief Atraso nao bloqueante: consultar com delay_expired()
+ *
+ * Marcado em get_time_us(), de modo que continua valido apos uma troca de relogio
+ */
+typedef struct {
+    uint64_t end;  //!< get_time_us() no fim do atraso
+} delay_t;
+
+/**
+ * @brief Resultado de delay_selftest()
+ */
+typedef struct {
+    uint32_t us[DELAY_TEST_N];      //!< duracoes pedidas
+    int32_t err_ns[DELAY_TEST_N];   //!< duracao medida pelo PIT menos a pedida
+    int32_t lpo_err_permil;         //!< DELAY_TEST_LPO_MS medidos pelo LPO, em relacao ao esperado
+} delay_selftest_t;
+
+/**
+ * @brief Calibra os atrasos com a frequencia atual do nucleo
+ *
+ * Deve ser chamada apos SysTick_init() e apos cada mudanca de relogio
+ */
+void delay_init(void);
+/**
+ * @brief Espera us microssegundos
+ *
+ * As interrupcoes devem estar habilitadas se us for maior que um periodo do SysTick
+ *
+ * @param[in] us atraso em microssegundos
+ */
+void delay_us(uint32_t us);
+/**
+ * @brief Inicia um atraso nao bloqueante
+ *
+ * @param[out] delay atraso
+ * @param[in] us duracao em microssegundos
+ */
+void delay_start(delay_t *delay, uint32_t us);
+/**
+ * @brief Verifica se o atraso terminou
+ *
+ * @param[in] delay atraso iniciado por delay_start()
+ * @return 1 se terminou, 0 caso contrario
+ */
+uint8_t delay_expired(const delay_t *delay);
+/**
+ * @brief Chama fn apos pelo menos us microssegundos (roda de temporizadores)
+ *
+ * Resolucao de um tick do SysTick: o atraso eh arredondado para cima
+ *
+ * @param[in,out] timer temporizador
+ * @param[in] us atraso em microssegundos
+ * @param[in] fn funcao chamada na expiracao (contexto de ISR)
+ * @param[in] arg argumento passado a fn
+ */
+void delay_callback(swtimer_t *timer, uint32_t us, swtimer_fn_t fn, void *arg);
+/**
+ * @brief Mede a precisao de delay_us()
+ *
+ * Mede atrasos tipicos do LCD com o PIT canal 1 (relogio do barramento) e um
+ * atraso longo com o LPTMR (LPO, oscilador independente do nucleo). Usa o PIT
+ * canal 1 e o LPTMR: nao deve ser chamada com o jogo em andamento.
+ *
+ * O PIT canal 1 tambem esvazia a fila do LCD: espera GPIO_LCD_fila_vazia() antes
+ * de toma-lo, e nada pode ser enfileirado (nem de interrupcoes) ate o retorno
+ *
+ * @param[out] result resultado
+ */
+void delay_selftest(delay_selftest_t *result);
+/**
+ * @brief Executa delay_selftest() e mostra o resultado no LCD
+ *
+ * Linha 1: maior erro absoluto dos atrasos curtos (ns); linha 2: desvio em
+ * relacao ao LPO (por mil)
+ */
+void delay_selftest_run(void);
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file fsm.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos, macros e tipos de dados da maquina de estados por tabela
+ *
+ * A maquina eh descrita por uma tabela estado x evento -> (acao, proximo estado)
+ * e por acoes de entrada e saida de cada estado. Eventos podem ser postados de
+ * qualquer contexto (inclusive ISRs) com fsm_post(); as transicoes so acontecem
+ * em fsm_run(), chamada sempre do mesmo contexto, uma de cada vez: saida do
+ * estado atual, acao da transicao, entrada no proximo e so entao a troca do
+ * estado visivel por fsm_state(). Transicoes internas (proximo estado FSM_STAY)
+ * executam apenas a acao.
+ *
+ * Para cada estado sao registrados o tempo total nele e o numero de entradas;
+ * para cada celula da tabela, quantas vezes foi usada.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _FSM_H
+#define _FSM_H
+
+#include <stdint.h>
+
+#define FSM_MAX_STATES 8
+#define FSM_MAX_EVENTS 8  // eventos pendentes ficam num mapa de bits de 8 bits
+#define FSM_STAY 0xFF     // transicao interna: nao sai do estado
+
+// celulas da tabela; celulas nao inicializadas ignoram o evento
+#define FSM_GOTO(next, action) {(action), (next), 1}
+#define FSM_INTERNAL(action) {(action), FSM_STAY, 1}
+
+typedef void (*fsm_action_t)(void);
+
+/**
+ * @brief Celula da tabela de transicoes (preencher com FSM_GOTO() ou FSM_INTERNAL())
+ */
+typedef struct {
+    fsm_action_t action;  //!< executada entre a saida e a entrada (pode ser NULL)
+    uint8_t next;         //!< proximo estado ou FSM_STAY
+    uint8_t used;         //!< 0: evento ignorado neste estado
+} fsm_transition_t;
+
+/**
+ * @brief Acoes de entrada e saida de um estado (podem ser NULL)
+ */
+typedef struct {
+    fsm_action_t entry;
+    fsm_action_t exit;
+} fsm_state_t;
+
+/**
+ * @brief Estatisticas da maquina
+ */
+typedef struct {
+    uint64_t time_us[FSM_MAX_STATES];                   //!< tempo total em cada estado (ate a ultima saida)
+    uint32_t entries[FSM_MAX_STATES];                   //!< entradas em cada estado
+    uint32_t transitions[FSM_MAX_STATES][FSM_MAX_EVENTS];  //!< usos de cada celula da tabela
+    uint32_t ignored;                                   //!< eventos sem celula no estado atual
+} fsm_stats_t;
+
+/**
+ * @brief Maquina de estados
+ */
+typedef struct {
+    const fsm_state_t *states;       //!< n_states acoes de entrada e saida
+    const fsm_transition_t *table;   //!< n_states x n_events, indexada por [estado * n_events + evento]
+    uint8_t n_states;
+    uint8_t n_events;
+    volatile uint8_t state;          //!< estado atual
+    volatile uint8_t pending;        //!< eventos postados e ainda nao tratados (bit = evento)
+    uint64_t t_entry;                //!< entrada no estado atual (us)
+    fsm_stats_t stats;
+} fsm_t;
+
+/**
+ * @brief Inicializa a maquina e entra no estado inicial (executa sua acao de entrada)
+ *
+ * @param[out] fsm maquina
+ * @param[in] states acoes de entrada e saida de cada estado
+ * @param[in] table tabela de transicoes (n_states x n_events)
+ * @param[in] n_states numero de estados (ate FSM_MAX_STATES)
+ * @param[in] n_events numero de eventos (ate FSM_MAX_EVENTS)
+ * @param[in] initial estado inicial
+ */
+void fsm_init(fsm_t *fsm, const fsm_state_t *states, const fsm_transition_t *table, uint8_t n_states,
+              uint8_t n_events, uint8_t initial);
+/**
+ * @brief Posta um evento; pode ser chamada de ISRs
+ *
+ * Um evento postado de novo antes de ser tratado conta uma so vez
+ *
+ * @param[in,out] fsm maquina
+ * @param[in] event evento
+ */
+void fsm_post(fsm_t *fsm, uint8_t event);
+/**
+ * @brief Trata os eventos pendentes, inclusive os postados pelas proprias acoes
+ *
+ * Eventos pendentes ao mesmo tempo sao tratados em ordem crescente de numero
+ *
+ * @param[in,out] fsm maquina
+ */
+void fsm_run(fsm_t *fsm);
+/**
+ * @brief Estado atual
+ *
+ * @param[in] fsm maquina
+ * @return estado atual
+ */
+static inline uint8_t fsm_state(const fsm_t *fsm) {
+    return fsm->state;
+}
+
+#endif
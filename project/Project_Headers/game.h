@@ -11,107 +11,107 @@
 
 #include <stdint.h>
 
-typedef enum {
-    PLAYER_NONE,
-    PLAYER_1,
-    PLAYER_2
-} player_t;
+#include "board.h"
+#include "fsm.h"
+#include "input.h"
 
+/**
+ * @brief Estados do jogo (maquina de estados de game.c)
+ */
 typedef enum {
-    LEFT,
-    MIDDLE,
-    RIGHT
-} region_t;
-
-typedef struct {
-    float x;
-    float y;
-} vector_2d_t;
-
-typedef struct {
-    uint8_t sets;
-    uint8_t games;
-    uint8_t points;
-} score_t;
-
-typedef struct {
-    vector_2d_t ball_pos;
-    vector_2d_t ball_vel;
-    score_t score[2];
-    uint8_t bounces_left;
-    uint8_t bounces_right;
-} board_t;
+    INICIO,       //!< tela de inicio, espera PTA12
+    PLAYER_TURN,  //!< ponto em andamento (fisica no PIT)
+    LCD_UPDATE,   //!< ponto encerrado: placar sendo atualizado
+    WIN_VISU,     //!< tela de vencedor por GAME_WIN_SCREEN_MS
+    GAME_N_STATES
+} state_t;
 
 /**
  * @brief Loop de execucao do jogo
  *
+ * Cadastra as tarefas de controle, audio, LCD e OLED no escalonador (sched.h),
+ * entra no estado INICIO e passa o controle ao escalonador; a fisica roda em
+ * game_physics_tick(). O fluxo do jogo eh uma maquina de estados por tabela
+ * (fsm.h) executada pela tarefa de controle. Sem tarefa pronta o nucleo dorme
+ * (power_idle())
+ *
  * @param[in] sets_to_win
+ * @param[in] ai_player jogador controlado pelo microcontrolador (PLAYER_NONE: dois jogadores)
  * @noreturn
  */
-void game_loop(uint8_t sets_to_win);
+void game_loop(uint8_t sets_to_win, player_t ai_player);
 /**
- * @brief Mostra no OLED um padrao de zadrez
+ * @brief Passo da fisica durante o ponto (chamada por PIT_IRQHandler a PHYSICS_TICK_HZ)
  *
- * Mostra apenas fora da regiao reservada para informacoes
+ * Avanca a bola, habilita os botoes do lado em que ela esta, executa o jogador
+ * controlado pelo microcontrolador e, quando alguem vence o ponto, desliga o PIT e
+ * posta o evento que leva a LCD_UPDATE
  *
+ * @param[in,out] board estrutura do estado da partida
  */
-void game_display_checkerboard(void);
+void game_physics_tick(board_t *board);
 /**
- * @brief Mostra no OLED na regiao reservada para informacoes como iniciar a partida
+ * @brief Trata um evento de botao durante o ponto (chamada por PIT_IRQHandler)
+ *
+ * Aceita a rebatida apenas do botao do jogador da vez, se ele nao for controlado
+ * pelo microcontrolador e a bola estiver do seu lado da rede; a rebatida eh
+ * aplicada no instante da borda (historico dos ultimos passos da fisica). Bordas
+ * anteriores ao lancamento da bola sao descartadas
  *
+ * @param[in,out] board estrutura do estado da partida
+ * @param[in] ev evento retirado da fila (input.h)
  */
-void game_start_screen_display(void);
+void game_play_input(board_t *board, const input_event_t *ev);
 /**
- * @brief Mostra no OLED na regiao reservada para informacoes o jogador vencedor
+ * @brief Libera a tarefa de controle apos um evento; pode ser chamada de ISRs
  *
- * @param[in] winner jogador vencedor da partida
+ * Nas telas de espera a tarefa de controle nao eh periodica
  */
-void game_winner_screen_display(player_t winner);
-
+void game_wake(void);
 /**
- * @brief Reinicia a partida
+ * @brief Estado atual do jogo; pode ser chamada de ISRs
  *
- * @param[in,out] board estrutura do estado da partida
+ * So muda ao fim de uma transicao completa (saida, acao e entrada)
+ *
+ * @return estado atual
  */
-void board_reset(board_t *board);
+state_t game_state(void);
 /**
- * @brief Atualiza o estado da partida
+ * @brief Copia as estatisticas da maquina de estados do jogo
  *
- * Faz os calculos da fisica dos elementos do jogo
+ * Tempo total em cada estado, entradas por estado e usos de cada transicao
  *
- * @param[in,out] board estrutura do estado da partida
- * @param[in] dt diferenca de tempo em milissegundos desde a ultima execucao
+ * @param[out] stats estatisticas
  */
-void board_update(board_t *board, uint32_t dt);
+void game_get_stats(fsm_stats_t *stats);
 /**
- * @brief Verifica se algum jogador venceu o ponto
+ * @brief Pede o som de rebatida; pode ser chamada de ISRs
  *
- * @param[in,out] board estrutura do estado da partida
- * @return jogador que venceu o ponto atual ou PLAYER_NONE caso nao haja vencedor
  */
-player_t board_check_winner_point(board_t *board);
+void game_hit_sound(void);
 /**
- * @brief Verifica se algum jogador venceu a partida
+ * @brief Mostra no OLED um padrao de zadrez
+ *
+ * Mostra apenas fora da regiao reservada para informacoes
  *
- * @param[in,out] board estrutura do estado da partida
- * @param[in] sets_to_win
- * @return jogador que venceu a partida ou PLAYER_NONE caso nao haja vencedor
  */
-player_t board_check_winner_match(board_t *board, uint8_t sets_to_win);
+void game_display_checkerboard(void);
 /**
- * @brief Reposiciona a bola no meio da quadra e da uma velocidade inicial aleatoria
+ * @brief Mostra no OLED na regiao reservada para informacoes como iniciar a partida
  *
- * @param[in,out] board estrutura do estado da partida
  */
-void board_reset_ball(board_t *board);
+void game_start_screen_display(void);
 /**
- * @brief Registra um rebatimento da bola e atualiza sua velocidade
+ * @brief Mostra no OLED na regiao reservada para informacoes o jogador vencedor
  *
- * @param[in,out] board estrutura do estado da partida
+ * @param[in] winner jogador vencedor da partida
  */
-void board_hit_ball(board_t *board);
+void game_winner_screen_display(player_t winner);
+
 /**
- * @brief Atualiza o placar da partida e o LCD
+ * @brief Atualiza o placar da partida e pede a atualizacao do LCD
+ *
+ * A escrita no LCD eh feita pela tarefa de LCD de game_loop()
  *
  * @param[in,out] board estrutura do estado da partida
  * @param[in] winner vencedor do ponto
@@ -121,25 +121,55 @@ void board_update_score(board_t *board, player_t winner, uint8_t games_to_set);
 /**
  * @brief Mostra no LCD um placar vazio
  *
+ * Escreve no espelho da DDRAM; o LCD muda em GPIO_LCD_atualiza()
  */
 void board_init_LCD();
 /**
  * @brief Atualiza no LCD a contagem de games para cada jogador
  *
+ * Se o game fechou um set, o vencedor recebe LCD_GLIFO_SET ao lado da contagem
+ *
+ * Escreve no espelho da DDRAM; o LCD muda em GPIO_LCD_atualiza()
+ *
  * @param[in,out] board estrutura do estado da partida
  */
 void board_update_LCD_games(board_t *board);
 /**
  * @brief Atualiza no LCD a contagem de pontos para cada jogador
  *
+ * A vantagem (SCORE_AD) aparece como o caractere LCD_GLIFO_AD. Escreve no
+ * espelho da DDRAM; o LCD muda em GPIO_LCD_atualiza()
+ *
  * @param[in,out] board estrutura do estado da partida
  */
 void board_update_LCD_points(board_t *board);
+/**
+ * @brief Marca um jogador no LCD com um caractere customizado ao lado do nome
+ *
+ * O outro jogador fica sem marca. Escreve no espelho da DDRAM; o LCD muda em
+ * GPIO_LCD_atualiza()
+ *
+ * @param[in] player jogador marcado (PLAYER_NONE: nenhum)
+ * @param[in] glyph caractere (tipo_lcd_glifo)
+ */
+void board_update_LCD_marker(player_t player, uint8_t glyph);
 /**
  * @brief Mostra no OLED a visualizacao do estado atual da partida
  *
  * @param[in,out] board estrutura do estado da partida
  */
 void board_display(board_t *board);
+/**
+ * @brief Desenha o chao e a rede no buffer do OLED
+ *
+ */
+void board_draw_court(void);
+/**
+ * @brief Desenha a bola no buffer do OLED, se ela estiver dentro da tela
+ *
+ * @param[in] x_pos posicao horizontal da bola (pixels)
+ * @param[in] y_pos posicao vertical da bola (pixels)
+ */
+void board_draw_ball(float x_pos, float y_pos);
 
 #endif
@@ -0,0 +1,87 @@
+/**
+ * @file input.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos, macros e tipos de dados da fila de eventos dos botoes
+ *
+ * Fila circular de um produtor e um consumidor, sem desabilitar interrupcoes: o
+ * produtor so escreve input.head e o consumidor so escreve input.tail. O produtor
+ * eh PORTA_IRQHandler ou, no fim da janela de repiques, SysTick_Handler; os dois
+ * tem prioridade 0 e nao se interrompem. Durante o ponto o consumidor eh o passo
+ * da fisica (PIT_IRQHandler); nas telas de espera, com o PIT desligado, eh a
+ * tarefa de controle de game.c. Os dois nunca consomem ao mesmo tempo.
+ *
+ * Antes de enfileirar, input_edge() filtra os repiques: os botoes interrompem nas
+ * duas bordas e a primeira borda de um pino abre uma janela de INPUT_LOCKOUT_MS;
+ * as bordas dentro dela sao contadas como repiques e nao reiniciam a janela. Se a
+ * ISR le o pino em 0 com o botao solto, o pressionamento eh aceito na hora; no
+ * fim da janela um temporizador (swtimer.h) le o nivel ja estavel e aceita o
+ * pressionamento cuja primeira borda foi lida em 1, com o instante dessa borda.
+ * Cada pressionamento aceito libera a tarefa de controle (game_wake()).
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _INPUT_H
+#define _INPUT_H
+
+#include <stdint.h>
+
+#define INPUT_QUEUE_LEN 16  // potencia de 2; um evento a mais que isso eh descartado
+#define INPUT_LOCKOUT_MS 20  // pino estavel por esse tempo antes de um pressionamento
+#define INPUT_N_PINS 3       // PTA4, PTA5 e PTA12
+
+/**
+ * @brief Borda de um botao
+ */
+typedef struct {
+    uint32_t t;   //!< instante da borda (SysTick_getCycles32())
+    uint8_t pin;  //!< pino de PORTA (4, 5 ou 12)
+} input_event_t;
+
+/**
+ * @brief Converte INPUT_LOCKOUT_MS em ciclos do nucleo
+ *
+ * Chamar apos toda troca de perfil de relogio (clock_switch())
+ */
+void input_init(void);
+/**
+ * @brief Borda num botao (chamada por PORTA_IRQHandler): filtra repiques e enfileira os pressionamentos
+ *
+ * @param[in] pin pino de PORTA (4, 5 ou 12)
+ * @param[in] t instante da borda (SysTick_getCycles32())
+ * @param[in] pressed 1 se o pino estava em 0 na leitura da ISR
+ * @return 1 se um pressionamento foi enfileirado agora, 0 caso contrario (pode
+ * ser enfileirado no fim da janela)
+ */
+uint8_t input_edge(uint8_t pin, uint32_t t, uint8_t pressed);
+/**
+ * @brief Enfileira um evento (apenas o produtor)
+ *
+ * @param[in] pin pino de PORTA
+ * @param[in] t instante da borda
+ * @return 1 se enfileirado, 0 se a fila estava cheia
+ */
+uint8_t input_push(uint8_t pin, uint32_t t);
+/**
+ * @brief Retira o evento mais antigo (apenas o consumidor)
+ *
+ * @param[out] ev evento retirado
+ * @return 1 se havia evento, 0 se a fila estava vazia
+ */
+uint8_t input_pop(input_event_t *ev);
+/**
+ * @brief Eventos descartados por fila cheia desde o inicio
+ *
+ * @return numero de eventos descartados
+ */
+uint32_t input_dropped(void);
+/**
+ * @brief Bordas rejeitadas como repique num pino desde o inicio
+ *
+ * @param[in] pin pino de PORTA (4, 5 ou 12)
+ * @return numero de bordas rejeitadas
+ */
+uint32_t input_rejected(uint8_t pin);
+
+#endif
@@ -0,0 +1,66 @@
+/**
+ * @file latency.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos e macros da medida de latencia do botao ate a tela
+ *
+ * Uma rebatida eh marcada em quatro pontos: borda do botao (evento de input.h),
+ * aplicacao de board_hit_ball() (passo da fisica), inicio do primeiro quadro que
+ * a contem e fim da transferencia desse quadro ao OLED. As tres latencias a
+ * partir da borda sao acumuladas nos histogramas PROF_LAT_* de prof.h e aparecem
+ * nas paginas do LCD.
+ *
+ * Compilando com -DLATENCY_SCOPE, LATENCY_SCOPE_PIN vai a 1 na borda e volta a 0
+ * no fim da transferencia: com uma ponta no botao e outra no pino, o osciloscopio
+ * mede a latencia sem depender do SysTick.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _LATENCY_H
+#define _LATENCY_H
+
+#include <stdint.h>
+
+#define LATENCY_SCOPE_PIN 20  // PTE20, livre na FRDM-KL25Z
+
+/**
+ * @brief Configura o pino do osciloscopio (apenas com -DLATENCY_SCOPE)
+ */
+void latency_init(void);
+/**
+ * @brief Pressionamento aceito de PTA4 ou PTA5 (chamada por PORTA_IRQHandler)
+ *
+ * So sobe o pino do osciloscopio: o instante da borda vem do evento (input.h)
+ */
+void latency_edge(void);
+/**
+ * @brief Rebatida aplicada a bola (chamada pelo passo da fisica apos board_hit_ball())
+ *
+ * @param[in] t_edge instante da borda que pediu a rebatida (input_event_t.t)
+ */
+void latency_hit(uint32_t t_edge);
+/**
+ * @brief Retira a rebatida aplicada ainda nao desenhada
+ *
+ * Chamar junto com a copia do estado da partida, com interrupcoes desabilitadas,
+ * para que a copia contenha a rebatida retirada
+ *
+ * @param[out] t_edge instante da borda (ciclos, como prof_begin())
+ * @return 1 se havia rebatida pendente, 0 caso contrario
+ */
+uint8_t latency_take(uint32_t *t_edge);
+/**
+ * @brief Inicio do quadro que contem a rebatida retirada por latency_take()
+ *
+ * @param[in] t_edge instante da borda
+ */
+void latency_frame_begin(uint32_t t_edge);
+/**
+ * @brief Fim da transferencia do quadro que contem a rebatida
+ *
+ * @param[in] t_edge instante da borda
+ */
+void latency_frame_end(uint32_t t_edge);
+
+#endif
@@ -11,17 +11,22 @@
 
 #include <MKL25Z4.h>
 
+#include "clock.h"
 #include "GPIO_lcd.h"
 #include "GPIO_switches.h"
 #include "I2C_OLED.h"
 #include "OSC.h"
+#include "PIT.h"
 #include "RTC.h"
 #include "SIM.h"
+#include "SysTick.h"
 #include "TPM.h"
 
-#define SCREEN_WIDTH 128
-#define SCREEN_HEIGHT 64
-#define BTN_IRQC 0b1010  // falling edge
+#define BTN_IRQC 0b1011  // either edge (repiques filtrados por input_edge())
+#define SYSTICK_HZ 1000                // interrupcoes do SysTick por segundo
+#define PHYSICS_TICK_HZ 500                       // passo da fisica (PIT canal 0)
+#define PHYSICS_TICK_US 1000000 / PHYSICS_TICK_HZ
+#define SEED_LPO_TICKS 32  // periodos do LPO (1 ms) amostrados por get_seed()
 
 /**
  * @brief Configuracao basica do microncontrolador e perifericos
@@ -29,15 +34,31 @@
  */
 void config(void);
 /**
- * @brief Reinicia o RTC em zero
+ * @brief (Re)inicia o SysTick com a frequencia do perfil de relogio atual
  *
+ * A base de tempo continua a partir de now_us, de modo que get_time_us()
+ * permanece monotonico apos uma troca de relogio
+ *
+ * @param[in] now_us tempo atual em microssegundos
+ */
+void rebase_time_us(uint64_t now_us);
+/**
+ * @brief Obtem o tempo desde config(), medido pelo SysTick
+ *
+ * Monotonico, com resolucao de 1 us; pode ser chamada de ISRs
+ *
+ * @return tempo em microssegundos
  */
-void reset_time(void);
+uint64_t get_time_us(void);
 /**
- * @brief Obtem o tempo medido pelo modulo RTC
+ * @brief Gera uma semente para o gerador de numeros pseudo-aleatorios
+ *
+ * Conta as voltas de um laco durante SEED_LPO_TICKS periodos do LPO (RTC deve
+ * estar inicializado). Compilando com -DPRNG_SEED=<valor> a semente fica fixa,
+ * para execucoes reproduziveis
  *
- * @return tempo em milissegundos
+ * @return semente
  */
-uint32_t get_time(void);
+uint32_t get_seed(void);
 
 #endif
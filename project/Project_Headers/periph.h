@@ -0,0 +1,200 @@
+/**
+ * @file periph.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Configuracao dos perifericos em tempo de compilacao (I2C do OLED e TPM do som)
+ *
+ * Versoes "static inline" dos drivers de I2C e TPM: chamadas com o modulo, a
+ * alternativa de pinos e o canal constantes (OLED_I2C, SOUND_TPM, ...), com
+ * otimizacao (-O1 ou mais) as escolhas por modulo desaparecem e cada acesso
+ * vira uma escrita direta no endereco do registrador, sem vetor de ponteiros
+ * base. I2C.c e TPM.c apenas repassam para estas funcoes com o modulo variavel
+ * (unica copia do codigo); usar I2C.h/TPM.h quando os parametros nao forem
+ * constantes.
+ *
+ * periph_bench() compara os dois caminhos em ciclos do nucleo (-DPERIPH_BENCH).
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _PERIPH_H
+#define _PERIPH_H
+
+#include <stdint.h>
+
+#include "I2C.h"
+#include "bme.h"
+#include "mcu.h"
+
+// OLED (SSD1306): I2C0 em PTB0/PTB1
+#define OLED_I2C 0
+#define OLED_I2C_ALT ALT1
+#define OLED_I2C_MULT MULT0
+
+// som de rebatida: TPM1 canal 1 em PTE21
+#define SOUND_TPM 1
+#define SOUND_TPM_CH 1
+
+#define PERIPH_INLINE static inline __attribute__((always_inline))
+
+/**
+ * @brief Resultado de periph_bench()
+ */
+typedef struct {
+    uint32_t i2c_runtime;  //!< ciclos por byte de I2C_WriteByte() + I2C_Wait(), sem a espera do barramento
+    uint32_t i2c_const;    //!< ciclos por byte de periph_i2c_write_byte() + periph_i2c_wait(), idem
+    uint32_t tpm_runtime;  //!< ciclos de TPM_setaMOD() + TPM_setaCnV()
+    uint32_t tpm_const;    //!< ciclos de periph_tpm_set_mod() + periph_tpm_set_cnv()
+} periph_bench_t;
+
+/**
+ * @brief Ponteiro base do modulo I2Cx (constante quando x eh constante)
+ */
+PERIPH_INLINE I2C_MemMapPtr periph_i2c(uint8_t x) {
+    return x == 0 ? I2C0_BASE_PTR : I2C1_BASE_PTR;
+}
+/**
+ * @brief Ponteiro base do modulo TPMx (constante quando x eh constante)
+ */
+PERIPH_INLINE TPM_MemMapPtr periph_tpm(uint8_t x) {
+    return x == 0 ? TPM0_BASE_PTR : (x == 1 ? TPM1_BASE_PTR : TPM2_BASE_PTR);
+}
+
+/**
+ * @brief Mesmo que I2C_SetBaud()
+ */
+PERIPH_INLINE void periph_i2c_set_baud(uint8_t x, uint8_t mult, uint8_t icr) {
+    periph_i2c(x)->F = I2C_F_ICR(icr) | I2C_F_MULT(mult);
+}
+/**
+ * @brief Mesmo que I2C_Init(); apenas a alternativa pedida eh compilada
+ *
+ * @return 1 se a combinacao modulo/alternativa existe, 0 caso contrario
+ */
+PERIPH_INLINE uint8_t periph_i2c_init(uint8_t x, uint8_t alt, uint8_t mult, uint8_t icr) {
+    if (x == 0 && alt == ALT0) {
+        bme_or32(&SIM_SCGC5, SIM_SCGC5_PORTE_MASK);
+        bme_bfi32(&PORTE_PCR24, PORT_PCR_MUX_SHIFT, 3, 0x5);  // I2C0_SCL
+        bme_bfi32(&PORTE_PCR25, PORT_PCR_MUX_SHIFT, 3, 0x5);  // I2C0_SDA
+    } else if (x == 0 && alt == ALT1) {
+        bme_or32(&SIM_SCGC5, SIM_SCGC5_PORTB_MASK);
+        bme_bfi32(&PORTB_PCR0, PORT_PCR_MUX_SHIFT, 3, 0x2);  // I2C0_SCL
+        bme_bfi32(&PORTB_PCR1, PORT_PCR_MUX_SHIFT, 3, 0x2);  // I2C0_SDA
+    } else if (x == 0 && alt == ALT2) {
+        bme_or32(&SIM_SCGC5, SIM_SCGC5_PORTB_MASK);
+        bme_bfi32(&PORTB_PCR2, PORT_PCR_MUX_SHIFT, 3, 0x2);  // I2C0_SCL
+        bme_bfi32(&PORTB_PCR3, PORT_PCR_MUX_SHIFT, 3, 0x2);  // I2C0_SDA
+    } else if (x == 0 && alt == ALT3) {
+        bme_or32(&SIM_SCGC5, SIM_SCGC5_PORTC_MASK);
+        bme_bfi32(&PORTC_PCR8, PORT_PCR_MUX_SHIFT, 3, 0x2);  // I2C0_SCL
+        bme_bfi32(&PORTC_PCR9, PORT_PCR_MUX_SHIFT, 3, 0x2);  // I2C0_SDA
+    } else if (x == 1 && alt == ALT0) {
+        bme_or32(&SIM_SCGC5, SIM_SCGC5_PORTE_MASK);
+        bme_bfi32(&PORTE_PCR0, PORT_PCR_MUX_SHIFT, 3, 0x6);  // I2C1_SDA
+        bme_bfi32(&PORTE_PCR1, PORT_PCR_MUX_SHIFT, 3, 0x6);  // I2C1_SCL
+    } else if (x == 1 && alt == ALT1) {
+        bme_or32(&SIM_SCGC5, SIM_SCGC5_PORTA_MASK);
+        bme_bfi32(&PORTA_PCR3, PORT_PCR_MUX_SHIFT, 3, 0x2);  // I2C1_SCL
+        bme_bfi32(&PORTA_PCR4, PORT_PCR_MUX_SHIFT, 3, 0x2);  // I2C1_SDA
+    } else if (x == 1 && alt == ALT2) {
+        bme_or32(&SIM_SCGC5, SIM_SCGC5_PORTC_MASK);
+        bme_bfi32(&PORTC_PCR1, PORT_PCR_MUX_SHIFT, 3, 0x2);  // I2C1_SCL
+        bme_bfi32(&PORTC_PCR2, PORT_PCR_MUX_SHIFT, 3, 0x2);  // I2C1_SDA
+    } else if (x == 1 && alt == ALT3) {
+        bme_or32(&SIM_SCGC5, SIM_SCGC5_PORTC_MASK);
+        bme_bfi32(&PORTC_PCR10, PORT_PCR_MUX_SHIFT, 3, 0x2);  // I2C1_SCL
+        bme_bfi32(&PORTC_PCR11, PORT_PCR_MUX_SHIFT, 3, 0x2);  // I2C1_SDA
+    } else {
+        return 0;
+    }
+    bme_or32(&SIM_SCGC4, x == 0 ? SIM_SCGC4_I2C0_MASK : SIM_SCGC4_I2C1_MASK);
+    periph_i2c_set_baud(x, mult, icr);
+    periph_i2c(x)->C1 = I2C_C1_IICEN_MASK | I2C_C1_IICIE_MASK;
+    return 1;
+}
+/**
+ * @brief Mesmo que I2C_Start()
+ */
+PERIPH_INLINE void periph_i2c_start(uint8_t x) {
+    bme_or8(&periph_i2c(x)->C1, I2C_C1_TX_MASK);
+    bme_or8(&periph_i2c(x)->C1, I2C_C1_MST_MASK);  // MST 0 -> 1: condicao de START
+}
+/**
+ * @brief Mesmo que I2C_Stop()
+ */
+PERIPH_INLINE void periph_i2c_stop(uint8_t x) {
+    bme_and8(&periph_i2c(x)->C1, (uint8_t)~I2C_C1_MST_MASK);  // MST 1 -> 0: condicao de STOP
+    bme_and8(&periph_i2c(x)->C1, (uint8_t)~I2C_C1_TX_MASK);
+}
+/**
+ * @brief Mesmo que I2C_Wait()
+ */
+PERIPH_INLINE uint8_t periph_i2c_wait(uint8_t x) {
+    uint32_t i = 1000000;
+
+    while (!(periph_i2c(x)->S & I2C_S_IICIF_MASK) && i) {
+        i--;
+    }
+    bme_or8(&periph_i2c(x)->S, I2C_S_IICIF_MASK);  // w1c
+    return i != 0;
+}
+/**
+ * @brief Mesmo que I2C_WaitStop()
+ * @note https://community.nxp.com/t5/Kinetis-Microcontrollers/Why-is-there-a-pause-in-I2C-routines/td-p/245449
+ */
+PERIPH_INLINE void periph_i2c_wait_stop(uint8_t x) {
+    while (periph_i2c(x)->S & I2C_S_BUSY_MASK) {
+    }
+}
+/**
+ * @brief Mesmo que I2C_WriteByte()
+ */
+PERIPH_INLINE void periph_i2c_write_byte(uint8_t x, uint8_t data) {
+    periph_i2c(x)->D = data;
+}
+/**
+ * @brief Mesmo que I2C_WriteMultData()
+ */
+PERIPH_INLINE void periph_i2c_write(uint8_t x, uint8_t slave, uint32_t n_data, const uint8_t *data) {
+    periph_i2c_start(x);
+    periph_i2c_write_byte(x, (uint8_t)((slave << 1) | I2C_WRITE));
+    periph_i2c_wait(x);
+    for (; n_data; n_data--, data++) {
+        periph_i2c_write_byte(x, *data);
+        periph_i2c_wait(x);
+    }
+    periph_i2c_stop(x);
+    periph_i2c_wait_stop(x);
+}
+
+/**
+ * @brief Mesmo que TPM_setaMOD()
+ */
+PERIPH_INLINE void periph_tpm_set_mod(uint8_t x, uint16_t mod) {
+    periph_tpm(x)->MOD = TPM_MOD_MOD(mod);
+}
+/**
+ * @brief Mesmo que TPM_setaCnV()
+ */
+PERIPH_INLINE void periph_tpm_set_cnv(uint8_t x, uint8_t n, uint16_t valor) {
+    periph_tpm(x)->CONTROLS[n].CnV = TPM_CnV_VAL(valor);
+}
+
+/**
+ * @brief Mede em ciclos do nucleo o laco de bytes do I2C e a atualizacao do TPM
+ * pelos dois caminhos (I2C.h/TPM.h com o modulo variavel e parametros constantes)
+ *
+ * No I2C envia ao OLED uma sequencia de NOPs (SSD1306_NOP) e mede so a parte de
+ * CPU de cada byte (escrita em D e limpeza de IICIF): a espera pelo fim do byte
+ * (~90 us a 100 kHz) fica fora da medida. No TPM reescreve os valores atuais de
+ * MOD e CnV. Nenhum dos dois altera a tela ou o som
+ *
+ * @param[out] out ciclos de cada caminho
+ */
+void periph_bench(periph_bench_t *out);
+/**
+ * @brief Executa periph_bench() e mostra o resultado no LCD
+ */
+void periph_bench_run(void);
+
+#endif
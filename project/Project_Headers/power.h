@@ -0,0 +1,69 @@
+/**
+ * @file power.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos e tipos de dados do modo ocioso de baixo consumo
+ *
+ * power_idle() eh a funcao ociosa do escalonador (sched_set_idle()). Sem tarefa
+ * pronta, o nucleo dorme em WFI ate a proxima interrupcao. Com power_set_deep(1)
+ * (telas de espera, sem SysTick curto nem PIT necessarios) e folga de ao menos
+ * POWER_DEEP_MIN_MS, entra em VLPS e o LPTMR (LPO 1 kHz) acorda o nucleo na
+ * proxima expiracao da roda de temporizadores; os botoes do PORTA acordam a
+ * qualquer momento. Como SysTick e PIT param em VLPS, os ticks perdidos sao
+ * repostos na volta.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _POWER_H
+#define _POWER_H
+
+#include <stdint.h>
+
+#define POWER_DEEP_MIN_MS 20  // abaixo disso WFI: nao compensa a saida do VLPS
+
+/**
+ * @brief Estatisticas do modo ocioso
+ */
+typedef struct {
+    uint32_t sleeps;         //!< entradas em WFI
+    uint32_t deep_sleeps;    //!< entradas em VLPS
+    uint32_t wake_systick;   //!< despertares por motivo (interrupcao pendente ao acordar)
+    uint32_t wake_pit;
+    uint32_t wake_porta;
+    uint32_t wake_lptmr;
+    uint32_t wake_other;
+    uint64_t us_asleep;      //!< tempo dormindo em us (VLPS contado em ticks do LPTMR)
+    uint32_t last_latency;   //!< ciclos entre o evento do SysTick/PIT e o despertar
+    uint32_t max_latency;
+} power_stats_t;
+
+/**
+ * @brief Habilita VLPS e o LPTMR usado para acordar
+ *
+ * Deve ser chamada uma unica vez apos o reset (SMC_PMPROT so aceita uma escrita)
+ *
+ * @param[in] prioridade prioridade da interrupcao do LPTMR (0 a 3)
+ */
+void power_init(uint8_t prioridade);
+/**
+ * @brief Permite ou nao o uso de VLPS pela funcao ociosa
+ *
+ * @param[in] deep 1: VLPS permitido; 0: apenas WFI
+ */
+void power_set_deep(uint8_t deep);
+/**
+ * @brief Funcao ociosa: dorme ate a proxima interrupcao
+ *
+ * Retorna sem dormir se alguma tarefa foi liberada desde a ultima busca do
+ * escalonador
+ */
+void power_idle(void);
+/**
+ * @brief Copia as estatisticas do modo ocioso
+ *
+ * @param[out] stats estatisticas
+ */
+void power_get_stats(power_stats_t *stats);
+
+#endif
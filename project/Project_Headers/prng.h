@@ -0,0 +1,57 @@
+/**
+ * @file prng.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos e tipos de dados do gerador de numeros pseudo-aleatorios
+ *
+ * Gerador xorshift32 com saida multiplicada por uma constante impar: so usa
+ * operacoes de 32 bits (barato no Cortex-M0+) e nao depende de perifericos, de
+ * modo que tambem eh usado pelas ferramentas do host.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _PRNG_H
+#define _PRNG_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t state;
+} prng_t;
+
+/**
+ * @brief Inicializa o gerador
+ *
+ * A mesma semente sempre produz a mesma sequencia
+ *
+ * @param[out] rng estado do gerador
+ * @param[in] seed semente (0 eh trocado por uma constante fixa)
+ */
+void prng_seed(prng_t *rng, uint32_t seed);
+/**
+ * @brief Sorteia um inteiro de 32 bits
+ *
+ * @param[in,out] rng estado do gerador
+ * @return valor sorteado
+ */
+uint32_t prng_next(prng_t *rng);
+/**
+ * @brief Sorteia um inteiro em [0, n)
+ *
+ * @param[in,out] rng estado do gerador
+ * @param[in] n limite superior (exclusivo)
+ * @return valor sorteado
+ */
+uint32_t prng_range(prng_t *rng, uint32_t n);
+/**
+ * @brief Sorteia um real em [min, max)
+ *
+ * @param[in,out] rng estado do gerador
+ * @param[in] min limite inferior
+ * @param[in] max limite superior
+ * @return valor sorteado
+ */
+float prng_float(prng_t *rng, float min, float max);
+
+#endif
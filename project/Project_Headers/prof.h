@@ -0,0 +1,103 @@
+/**
+ * @file prof.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos, macros e tipos de dados dos histogramas de tempo por fase do quadro
+ *
+ * Cada fase (fisica, verificacao do ponto, jogador automatico, rasterizacao,
+ * transferencia ao OLED, escrita no LCD) eh cronometrada com duas leituras do
+ * SysTick e acumulada num histograma de faixas fixas em potencias de 2 de
+ * microssegundos, mantido em RAM.
+ * O custo por medida eh pequeno o bastante para ficar habilitado sempre.
+ *
+ * Os tempos sao de relogio de parede: uma fase da tarefa de desenho inclui as
+ * interrupcoes (fisica, SysTick) atendidas durante ela.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _PROF_H
+#define _PROF_H
+
+#include <stdint.h>
+
+#define PROF_BUCKETS 18  // faixa k: [2^k, 2^(k+1)) us; a ultima acumula tudo acima de 2^17 us
+
+/**
+ * @brief Fases cronometradas
+ */
+typedef enum {
+    PROF_PHYSICS,  //!< board_update() no passo da fisica
+    PROF_WINNER,   //!< board_check_winner_point()
+    PROF_AI,       //!< ai_update() do jogador automatico
+    PROF_RASTER,   //!< desenho do quadro no buffer do OLED
+    PROF_OLED,     //!< I2C_OLED_redisplay()
+    PROF_LCD,      //!< escritas pedidas ao LCD
+    PROF_LAT_HIT,    //!< latencia: borda do botao ate board_hit_ball() (latency.h)
+    PROF_LAT_FRAME,  //!< latencia: borda do botao ate o inicio do quadro seguinte
+    PROF_LAT_PHOTON, //!< latencia: borda do botao ate o fim da transferencia desse quadro
+    PROF_N_PHASES
+} prof_phase_t;
+
+/**
+ * @brief Histograma de uma fase
+ */
+typedef struct {
+    uint32_t count;                  //!< medidas acumuladas
+    uint32_t max_us;                 //!< maior duracao
+    uint64_t total_us;               //!< soma das duracoes
+    uint32_t bucket[PROF_BUCKETS];   //!< medidas por faixa
+} prof_hist_t;
+
+/**
+ * @brief Le a frequencia do relogio do nucleo para converter ciclos em us
+ *
+ * Chamar apos toda troca de perfil de relogio (clock_switch())
+ */
+void prof_init(void);
+/**
+ * @brief Inicio de uma fase
+ *
+ * @return instante atual, a ser passado para prof_end()
+ */
+uint32_t prof_begin(void);
+/**
+ * @brief Fim de uma fase: acumula a duracao no histograma
+ *
+ * Pode ser chamada de ISRs, desde que cada fase seja medida sempre no mesmo contexto
+ *
+ * @param[in] phase fase medida
+ * @param[in] t0 valor retornado por prof_begin()
+ */
+void prof_end(prof_phase_t phase, uint32_t t0);
+/**
+ * @brief Copia o histograma de uma fase
+ *
+ * @param[in] phase fase
+ * @param[out] hist copia do histograma
+ */
+void prof_get(prof_phase_t phase, prof_hist_t *hist);
+/**
+ * @brief Limite superior (us) da faixa que contem o percentil pedido
+ *
+ * @param[in] hist histograma
+ * @param[in] permil percentil em milesimos (500: mediana, 990: p99)
+ * @return limite superior da faixa, ou 0 se nao houver medidas
+ */
+uint32_t prof_percentile(const prof_hist_t *hist, uint16_t permil);
+/**
+ * @brief Zera todos os histogramas
+ */
+void prof_reset(void);
+/**
+ * @brief Mostra no LCD o resumo de uma fase
+ *
+ * Linha 1: nome da fase e limite da faixa da mediana. Linha 2: limite da faixa
+ * do p99 e duracao maxima. Valores em us. Escreve no espelho da DDRAM; o LCD
+ * muda em GPIO_LCD_atualiza()
+ *
+ * @param[in] phase fase
+ */
+void prof_display_LCD(prof_phase_t phase);
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file sched.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos, macros e tipos de dados do escalonador cooperativo
+ *
+ * Tarefas executam ate o fim (sem preempcao entre elas). Cada tarefa eh
+ * periodica (period > 0) ou de disparo unico, liberada por sched_start() apos um
+ * atraso ou por sched_post() (inclusive de dentro de ISRs). Entre as tarefas
+ * prontas roda a de maior prioridade (menor numero) e, em caso de empate, a de
+ * liberacao mais antiga. Uma tarefa que comeca mais de "deadline" us depois de
+ * liberada conta uma perda de prazo, assim como cada periodo pulado.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _SCHED_H
+#define _SCHED_H
+
+#include <stdint.h>
+
+#define SCHED_MAX_TASKS 8
+#define SCHED_NONE -1
+
+typedef void (*sched_fn_t)(void *arg);
+
+/**
+ * @brief Estatisticas de execucao de uma tarefa
+ */
+typedef struct {
+    uint32_t runs;          //!< execucoes
+    uint32_t misses;        //!< inicios apos o prazo + periodos pulados
+    uint32_t max_late_us;   //!< maior atraso entre liberacao e inicio
+    uint32_t max_exec_us;   //!< maior tempo de execucao
+} sched_stats_t;
+
+/**
+ * @brief Cadastra uma tarefa
+ *
+ * Tarefas periodicas sao liberadas imediatamente; tarefas de disparo unico
+ * esperam sched_start() ou sched_post()
+ *
+ * @param[in] fn funcao da tarefa
+ * @param[in] arg argumento passado a fn
+ * @param[in] priority prioridade (0 = mais alta)
+ * @param[in] period_us periodo em us (0 = disparo unico)
+ * @param[in] deadline_us prazo para iniciar apos a liberacao, em us (0 = igual ao periodo)
+ * @return identificador da tarefa ou SCHED_NONE se a tabela estiver cheia
+ */
+int8_t sched_add(sched_fn_t fn, void *arg, uint8_t priority, uint32_t period_us, uint32_t deadline_us);
+/**
+ * @brief Libera a tarefa daqui a delay_us (reinicia a fase de tarefas periodicas)
+ *
+ * @param[in] id identificador da tarefa
+ * @param[in] delay_us atraso em us
+ */
+void sched_start(int8_t id, uint32_t delay_us);
+/**
+ * @brief Suspende a tarefa ate o proximo sched_start() ou sched_post()
+ *
+ * @param[in] id identificador da tarefa
+ */
+void sched_stop(int8_t id);
+/**
+ * @brief Libera a tarefa o quanto antes; pode ser chamada de ISRs
+ *
+ * @param[in] id identificador da tarefa
+ */
+void sched_post(int8_t id);
+/**
+ * @brief Altera o periodo de uma tarefa periodica a partir da proxima liberacao
+ *
+ * @param[in] id identificador da tarefa
+ * @param[in] period_us periodo em us
+ */
+void sched_set_period(int8_t id, uint32_t period_us);
+/**
+ * @brief Executa no maximo uma tarefa pronta
+ *
+ * @return 1 se alguma tarefa executou, 0 caso contrario
+ */
+uint8_t sched_run_once(void);
+/**
+ * @brief Define a funcao chamada quando nao ha tarefa pronta
+ *
+ * @param[in] idle funcao ociosa (NULL: nenhuma)
+ */
+void sched_set_idle(void (*idle)(void));
+/**
+ * @brief Instante da proxima liberacao de tarefa
+ *
+ * Usada pela funcao ociosa para decidir quanto tempo pode dormir; deve ser
+ * chamada com as interrupcoes desabilitadas para nao perder um sched_post()
+ *
+ * @return tempo em us (0 se ha tarefa liberada por evento, UINT64_MAX se nenhuma esta armada)
+ */
+uint64_t sched_next_release(void);
+/**
+ * @brief Laco do escalonador
+ *
+ * @noreturn
+ */
+void sched_run(void);
+/**
+ * @brief Copia as estatisticas de uma tarefa
+ *
+ * @param[in] id identificador da tarefa
+ * @param[out] stats estatisticas
+ */
+void sched_get_stats(int8_t id, sched_stats_t *stats);
+
+#endif
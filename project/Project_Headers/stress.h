@@ -0,0 +1,55 @@
+/**
+ * @file stress.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos e macros do modo de estresse com varias bolas
+ *
+ * Simula e desenha n bolas independentes (fisica em lote de board_batch.c) e
+ * procura o maior n que mantem STRESS_TARGET_FPS quadros por segundo no alvo.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _STRESS_H
+#define _STRESS_H
+
+#include <stdint.h>
+
+#include "board_batch.h"
+
+#define STRESS_MAX_BALLS 256  // 19 bytes de RAM por bola
+#define STRESS_TARGET_FPS 8   // taxa minima de quadros por segundo
+#define STRESS_FRAMES 16      // quadros medidos para cada n
+
+/**
+ * @brief Resultado da medicao com n bolas
+ */
+typedef struct {
+    uint32_t n;       //!< numero de bolas
+    uint32_t frames;  //!< quadros medidos
+    uint32_t us;      //!< tempo total dos quadros (us)
+    uint32_t points;  //!< bolas que encerraram um ponto (dois quiques ou fora) e foram relancadas
+} stress_result_t;
+
+/**
+ * @brief Mede a taxa de quadros com n bolas
+ *
+ * Cada quadro atualiza todas as bolas, verifica o fim do ponto de cada uma
+ * (relancando-a) e desenha a quadra e as bolas no OLED
+ *
+ * @param[in] n numero de bolas (ate STRESS_MAX_BALLS)
+ * @param[in] frames numero de quadros a medir
+ * @param[out] result resultado da medicao
+ */
+void stress_measure(uint32_t n, uint32_t frames, stress_result_t *result);
+/**
+ * @brief Modo de estresse
+ *
+ * Dobra n enquanto a taxa de quadros se mantem, refina por busca binaria, mostra
+ * no LCD o maior n sustentavel e a taxa obtida e segue animando com esse n
+ *
+ * @noreturn
+ */
+void stress_run(void);
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * @file swtimer.h
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Prototipos e tipos de dados dos temporizadores de software (roda de tempo)
+ *
+ * Roda com SWTIMER_SLOTS posicoes avancada por swtimer_tick() a cada
+ * interrupcao do SysTick (~1 ms). Cada temporizador fica na lista duplamente
+ * encadeada da posicao (expiracao % SWTIMER_SLOTS), de modo que iniciar e
+ * cancelar custam O(1); a cada tick so a lista da posicao atual eh percorrida.
+ *
+ * As funcoes de retorno executam dentro da ISR do SysTick: devem ser curtas,
+ * tipicamente so marcando um evento ou liberando uma tarefa (swtimer_start_post()).
+ * Podem iniciar ou cancelar qualquer temporizador; um temporizador expirado no
+ * mesmo tick e cancelado por uma funcao anterior nao dispara.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef _SWTIMER_H
+#define _SWTIMER_H
+
+#include <stdint.h>
+
+#define SWTIMER_SLOTS 64  // potencia de 2
+
+typedef void (*swtimer_fn_t)(void *arg);
+
+typedef struct swtimer {
+    struct swtimer *next;
+    struct swtimer *prev;
+    uint32_t expires;  //!< tick de expiracao
+    swtimer_fn_t fn;
+    void *arg;
+    uint8_t active;  //!< uso interno de swtimer.c; consultar com swtimer_active()
+} swtimer_t;
+
+/**
+ * @brief Inicia (ou reinicia) um temporizador de disparo unico
+ *
+ * @param[in,out] timer temporizador (deve permanecer valido enquanto ativo)
+ * @param[in] delay_ms atraso em ticks do SysTick (~ms); 0 dispara no proximo tick
+ * @param[in] fn funcao chamada na expiracao (contexto de ISR)
+ * @param[in] arg argumento passado a fn
+ */
+void swtimer_start(swtimer_t *timer, uint32_t delay_ms, swtimer_fn_t fn, void *arg);
+/**
+ * @brief Inicia um temporizador que libera uma tarefa do escalonador ao expirar
+ *
+ * @param[in,out] timer temporizador
+ * @param[in] delay_ms atraso em ticks do SysTick (~ms)
+ * @param[in] task identificador da tarefa (sched_add())
+ */
+void swtimer_start_post(swtimer_t *timer, uint32_t delay_ms, int8_t task);
+/**
+ * @brief Cancela o temporizador, se estiver ativo
+ *
+ * @param[in,out] timer temporizador
+ */
+void swtimer_cancel(swtimer_t *timer);
+/**
+ * @brief Verifica se o temporizador esta ativo
+ *
+ * @param[in] timer temporizador
+ * @return 1 se ativo, 0 caso contrario
+ */
+uint8_t swtimer_active(const swtimer_t *timer);
+/**
+ * @brief Ticks ate a proxima expiracao
+ *
+ * Percorre todos os temporizadores ativos: destinada a funcao ociosa, com as
+ * interrupcoes desabilitadas
+ *
+ * @return ticks ate o proximo disparo ou UINT32_MAX se nao ha temporizador ativo
+ */
+uint32_t swtimer_next(void);
+/**
+ * @brief Avanca a roda em um tick e dispara os temporizadores expirados
+ *
+ * Chamada por SysTick_Handler
+ */
+void swtimer_tick(void);
+
+#endif
@@ -15,12 +15,36 @@
 #define GPIO_PIN(x) ((1) << (x))
 
 /**
- * @brief Executa em multiplos de 2us sem outras alteracoes
+ * @brief Escreve v em decimal, alinhado a direita, nas "digits" posicoes de str
  *
- * Tempo final de execucao sera n * 2us
+ * Nao termina a string; digitos alem de "digits" sao descartados
  *
- * @param[in] n multiplica 2us
+ * @param[in] v valor
+ * @param[out] str destino
+ * @param[in] digits numero de posicoes
  */
-void espera_2us(uint32_t n);
+void util_formata(uint32_t v, char *str, uint8_t digits);
+/**
+ * @brief Desabilita as interrupcoes (inicio de secao critica)
+ *
+ * @return estado anterior de PRIMASK, para util_irq_restaura()
+ */
+static inline uint32_t util_irq_desativa(void) {
+    uint32_t primask;
+    asm volatile("mrs %0, primask \n\t"
+                 "cpsid i"
+                 : "=r"(primask)
+                 :
+                 : "memory");
+    return primask;
+}
+/**
+ * @brief Restaura o estado das interrupcoes (fim de secao critica)
+ *
+ * @param[in] primask valor retornado por util_irq_desativa()
+ */
+static inline void util_irq_restaura(uint32_t primask) {
+    asm volatile("msr primask, %0" : : "r"(primask) : "memory");
+}
 
 #endif /* UTIL_H_ */
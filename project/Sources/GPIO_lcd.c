@@ -7,83 +7,441 @@
 
 #include "GPIO_lcd.h"
 
+#include "bme.h"
+#include "delay.h"
 #include "mcu.h"
 #include "util.h"
 
+#define LCD_CURSOR_INVALIDO 0xFF
+#define LCD_FILA_RS 0x100  // bit de RS na entrada da fila (1: dado)
+#define LCD_E_NS 500       // largura do pulso E (minimo do HD44780: 450 ns)
+#define LCD_BENCH_N 64     // bytes medidos por caminho em GPIO_LCD_bench()
+
+// impede o compilador de reordenar acessos a memoria (nucleo unico: basta isso)
+#define LCD_BARRIER() asm volatile("" : : : "memory")
+
+// fila de bytes (produtor: codigo principal; consumidor: PIT canal 1)
+static struct {
+    uint16_t byte[LCD_FILA_LEN];  // byte | LCD_FILA_RS
+    volatile uint8_t head;        // proxima posicao livre (produtor)
+    volatile uint8_t tail;        // proximo byte (consumidor)
+    volatile uint8_t ativa;       // 1: canal 1 contando o tempo do ultimo byte enviado
+    uint32_t bus;                 // frequencia do barramento (Hz), base do PIT
+    uint32_t resto_us;            // tempo restante do byte em processamento (GPIO_LCD_fila_pausa())
+    GPIO_LCD_stats_t stats;
+} lcd_fila;
+
+// mapas 5x8 dos caracteres customizados, na ordem de tipo_lcd_glifo (bits 4-0 de cada linha)
+static const uint8_t lcd_glifos[LCD_N_GLIFOS][8] = {
+    {0x00, 0x0E, 0x1F, 0x1F, 0x1F, 0x0E, 0x00, 0x00},  // LCD_GLIFO_BOLA
+    {0x04, 0x0A, 0x0E, 0x0A, 0x0C, 0x0A, 0x0A, 0x0C},  // LCD_GLIFO_AD: "A" sobre "D"
+    {0x08, 0x0C, 0x0E, 0x0F, 0x0E, 0x0C, 0x08, 0x00},  // LCD_GLIFO_SAQUE
+    {0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00},  // LCD_GLIFO_SET
+};
+
+// espelho da DDRAM visivel: conteudo pedido e conteudo atual do LCD
+static uint8_t lcd_buffer[LCD_LINHAS][LCD_COLUNAS];
+static uint8_t lcd_ddram[LCD_LINHAS][LCD_COLUNAS];
+static uint8_t lcd_cursor = LCD_CURSOR_INVALIDO;  // contador de endereco do LCD
+static uint32_t lcd_e_voltas;  // voltas de lcd_espera_voltas() com E alto
+
+/**
+ * @brief Endereco DDRAM da celula (linha, coluna)
+ */
+static inline uint8_t lcd_endereco(uint8_t linha, uint8_t coluna) {
+    return (linha ? 0x40 : 0x00) + coluna;
+}
+
 void GPIO_LCD_ativa_con() {
-    SIM_SCGC5 |= SIM_SCGC5_PORTC_MASK;  // habilita sinal de clock de PORTC
+    bme_or32(&SIM_SCGC5, SIM_SCGC5_PORTC_MASK);  // habilita sinal de clock de PORTC
 
     // Configura os pinos conectados em Latch e LCD com funcao GPIO
-    PORTC_PCR0 |= PORT_PCR_MUX(0x1);  // D0-D7 dos dados
-    PORTC_PCR1 |= PORT_PCR_MUX(0x1);
-    PORTC_PCR2 |= PORT_PCR_MUX(0x1);
-    PORTC_PCR3 |= PORT_PCR_MUX(0x1);
-    PORTC_PCR4 |= PORT_PCR_MUX(0x1);
-    PORTC_PCR5 |= PORT_PCR_MUX(0x1);
-    PORTC_PCR6 |= PORT_PCR_MUX(0x1);
-    PORTC_PCR7 |= PORT_PCR_MUX(0x1);
-
-    PORTC_PCR8 |= PORT_PCR_MUX(0x1);  // RS do LCD
-    PORTC_PCR9 |= PORT_PCR_MUX(0x1);  // E do LCD
+    bme_bfi32(&PORTC_PCR0, PORT_PCR_MUX_SHIFT, 3, 0x1);  // D0-D7 dos dados
+    bme_bfi32(&PORTC_PCR1, PORT_PCR_MUX_SHIFT, 3, 0x1);
+    bme_bfi32(&PORTC_PCR2, PORT_PCR_MUX_SHIFT, 3, 0x1);
+    bme_bfi32(&PORTC_PCR3, PORT_PCR_MUX_SHIFT, 3, 0x1);
+    bme_bfi32(&PORTC_PCR4, PORT_PCR_MUX_SHIFT, 3, 0x1);
+    bme_bfi32(&PORTC_PCR5, PORT_PCR_MUX_SHIFT, 3, 0x1);
+    bme_bfi32(&PORTC_PCR6, PORT_PCR_MUX_SHIFT, 3, 0x1);
+    bme_bfi32(&PORTC_PCR7, PORT_PCR_MUX_SHIFT, 3, 0x1);
+
+    bme_bfi32(&PORTC_PCR8, PORT_PCR_MUX_SHIFT, 3, 0x1);  // RS do LCD
+    bme_bfi32(&PORTC_PCR9, PORT_PCR_MUX_SHIFT, 3, 0x1);  // E do LCD
 
     // Configura o sentido do sinal nos pinos PORTC0-10 como saida
-    GPIOC_PDDR |= GPIO_PDDR_PDD(GPIO_PIN(9) | GPIO_PIN(8) | GPIO_PIN(7) |
-                                GPIO_PIN(6) | GPIO_PIN(5) | GPIO_PIN(4) | GPIO_PIN(3) |
-                                GPIO_PIN(2) | GPIO_PIN(1) | GPIO_PIN(0));
+    bme_or32(&GPIOC_PDDR, GPIO_PDDR_PDD(GPIO_PIN(9) | GPIO_PIN(8) | GPIO_PIN(7) |
+                                        GPIO_PIN(6) | GPIO_PIN(5) | GPIO_PIN(4) | GPIO_PIN(3) |
+                                        GPIO_PIN(2) | GPIO_PIN(1) | GPIO_PIN(0)));
 }
 
 void GPIO_LCD_set_RS(tipo_lcd_RS i) {
+#ifdef LCD_GPIO_PONTE
     if (i == COMANDO) {
         GPIOC_PCOR = GPIO_PIN(8);  //!< Seta o LCD no modo de comando
     } else if (i == DADO) {
         GPIOC_PSOR = GPIO_PIN(8);  //!< Seta o LCD no modo de dados
     }
+#else
+    if (i == COMANDO) {
+        FGPIOC_PCOR = GPIO_PIN(8);
+    } else if (i == DADO) {
+        FGPIOC_PSOR = GPIO_PIN(8);
+    }
+#endif
 }
 
-void GPIO_LCD_escreve_byte(uint8_t c, uint16_t t) {
+/**
+ * @brief Calcula as voltas de lcd_espera_voltas() para a largura de E com o relogio atual
+ */
+static void lcd_calibra(void) {
+    lcd_e_voltas = (clock_get()->core / 1000000 * LCD_E_NS + 2999) / 3000;
+    if (lcd_e_voltas == 0) {
+        lcd_e_voltas = 1;
+    }
+}
+
+/**
+ * @brief Espera 3 ciclos do nucleo por volta (subs: 1 ciclo; bne tomado: 2 ciclos)
+ */
+static inline void lcd_espera_voltas(uint32_t n) {
+    asm volatile("1: subs %0, %0, #1 \n\t"
+                 "bne 1b"
+                 : "+l"(n)
+                 :
+                 : "cc");
+}
+
+/**
+ * @brief Caminho pela ponte de perifericos (GPIOC): PDOR em dois passos (AND e OR
+ * do BME, cada um atomico) e E cronometrado por delay_us()
+ */
+static void lcd_pulsa_ponte(uint8_t c) {
     /*!
      * Coloca os sinais do byte nos pinos PTC0-PTC7 (byte menos significativo da PORTC)
      */
-    GPIOC_PDOR &= ~0xff;
-    GPIOC_PDOR |= c;
+    bme_and32(&GPIOC_PDOR, ~0xffu);
+    bme_or32(&GPIOC_PDOR, c);
 
     /*!
      * Envia um pulso de E de largura maior que 450ns
      */
     GPIOC_PSOR = GPIO_PIN(9);
-    espera_2us(1);
+    delay_us(1);
     GPIOC_PCOR = GPIO_PIN(9);
+}
+
+/**
+ * @brief Caminho pelo IOPORT (FGPIOC): acessos de um ciclo, D0-D7 trocados numa
+ * unica escrita de PDOR e E alto por lcd_e_voltas voltas (ao menos LCD_E_NS)
+ */
+static void lcd_pulsa_ioport(uint8_t c) {
+    // RS e E (bits 8 e 9) preservados; E esta baixo, entao o LCD ignora a troca
+    FGPIOC_PDOR = (FGPIOC_PDOR & ~0xffu) | c;
+    FGPIOC_PSOR = GPIO_PIN(9);
+    lcd_espera_voltas(lcd_e_voltas);
+    FGPIOC_PCOR = GPIO_PIN(9);
+}
+
+/**
+ * @brief Coloca o byte no barramento e pulsa E, sem esperar o processamento
+ */
+static inline void lcd_pulsa(uint8_t c) {
+#ifdef LCD_GPIO_PONTE
+    lcd_pulsa_ponte(c);
+#else
+    lcd_pulsa_ioport(c);
+#endif
+}
+
+void GPIO_LCD_escreve_byte(uint8_t c, uint16_t t) {
+    lcd_pulsa(c);
 
     /*!
      * Aguarda pelo processamento
      */
-    espera_2us(t);
+    delay_us(t);
+}
+
+/**
+ * @brief Ciclos do barramento para ao menos us microssegundos (arredondado para cima,
+ * para nunca encurtar as esperas do HD44780); us <= 4294 nao estoura
+ */
+static uint32_t lcd_ciclos(uint32_t us) {
+    return us * (lcd_fila.bus / 1000000) + (us * (lcd_fila.bus % 1000000) + 999999) / 1000000;
+}
+
+/**
+ * @brief Envia o proximo byte da fila e programa o canal 1 com o seu tempo de processamento
+ *
+ * Chamada pela ISR do PIT ou, com a fila parada, por lcd_dispara() (interrupcoes desabilitadas)
+ */
+static void lcd_proximo(void) {
+    uint8_t tail = lcd_fila.tail;
+    uint16_t e, t;
+
+    if (tail == lcd_fila.head) {
+        PIT_desativa(1);
+        lcd_fila.ativa = 0;
+        return;
+    }
+    e = lcd_fila.byte[tail % LCD_FILA_LEN];
+    LCD_BARRIER();  // byte lido antes de liberar a posicao
+    lcd_fila.tail = tail + 1;
+
+    if (e & LCD_FILA_RS) {
+        GPIO_LCD_set_RS(DADO);
+        t = 43;
+    } else {
+        GPIO_LCD_set_RS(COMANDO);
+        t = (e & 0xFF) <= 0x03 ? 1530 : 39;  // Clear Display e Return Home sao lentos
+    }
+    lcd_pulsa(e & 0xFF);
+    lcd_fila.stats.bytes++;
+    lcd_fila.ativa = 1;
+    PIT_ativa(1, lcd_ciclos(t));
+}
+
+/**
+ * @brief Inicia o esvaziamento da fila caso o canal 1 esteja parado
+ */
+static void lcd_dispara(void) {
+    uint32_t primask = util_irq_desativa();
+    if (!lcd_fila.ativa) {
+        lcd_proximo();
+    }
+    util_irq_restaura(primask);
+}
+
+/**
+ * @brief Posicoes livres na fila
+ */
+static inline uint8_t lcd_livre(void) {
+    return LCD_FILA_LEN - (uint8_t)(lcd_fila.head - lcd_fila.tail);
+}
+
+/**
+ * @brief Coloca um byte na fila sem verificar espaco nem disparar o envio
+ */
+static void lcd_empilha(uint8_t c, tipo_lcd_RS rs) {
+    uint8_t head = lcd_fila.head, depth;
+
+    lcd_fila.byte[head % LCD_FILA_LEN] = c | (rs == DADO ? LCD_FILA_RS : 0);
+    LCD_BARRIER();  // byte completo antes de publicar
+    lcd_fila.head = head + 1;
+    depth = (uint8_t)(head + 1 - lcd_fila.tail);
+    if (depth > lcd_fila.stats.max_depth) {
+        lcd_fila.stats.max_depth = depth;
+    }
+}
+
+void GPIO_LCD_fila_init(void) {
+    uint32_t primask = util_irq_desativa();
+
+    lcd_fila.bus = clock_get()->bus;
+    lcd_calibra();
+    if (lcd_fila.ativa) {
+        // retoma a fila pausada com o resto do tempo do byte, no novo barramento
+        PIT_ativa(1, lcd_ciclos(lcd_fila.resto_us ? lcd_fila.resto_us : 1));
+    }
+    util_irq_restaura(primask);
+}
+
+void GPIO_LCD_fila_pausa(void) {
+    uint32_t primask = util_irq_desativa();
+    uint32_t cval;
+
+    if (lcd_fila.ativa) {
+        // contagem em ciclos do barramento atual: guarda em us, arredondado para cima
+        cval = PIT_leContagem(1);
+        lcd_fila.resto_us = PIT_limpaFlag(1) ? 0 : (uint32_t)(((uint64_t)cval * 1000000 + lcd_fila.bus - 1) / lcd_fila.bus);
+        PIT_desativa(1);  // ativa continua em 1: nada eh enviado ate GPIO_LCD_fila_init()
+    }
+    util_irq_restaura(primask);
+}
+
+void GPIO_LCD_fila_isr(void) {
+    lcd_proximo();
+}
+
+uint8_t GPIO_LCD_enfileira(uint8_t c, tipo_lcd_RS rs) {
+    if (lcd_livre() == 0) {
+        lcd_fila.stats.full++;
+        return 0;
+    }
+    lcd_empilha(c, rs);
+    lcd_cursor = LCD_CURSOR_INVALIDO;  // o comando pode mover o cursor
+    lcd_dispara();
+    return 1;
+}
+
+uint8_t GPIO_LCD_enfileira_string(uint8_t end, const uint8_t *str) {
+    const uint8_t *p;
+
+    for (p = str; *p != '\0'; p++) {
+    }
+    if (lcd_livre() < p - str + 1) {
+        lcd_fila.stats.full++;
+        return 0;
+    }
+    // Codifica o endereco na instrucao "Set DDRAM Address"
+    lcd_empilha(0b10000000 | end, COMANDO);
+    while (*str != '\0') {
+        lcd_empilha(*str, DADO);
+        if ((end & 0x3F) < LCD_COLUNAS) {
+            lcd_buffer[end >> 6][end & 0x3F] = *str;
+            lcd_ddram[end >> 6][end & 0x3F] = *str;
+        }
+        end++;
+        str++;
+    }
+    lcd_cursor = end;
+    lcd_dispara();
+    return 1;
+}
+
+uint8_t GPIO_LCD_fila_vazia(void) {
+    return !lcd_fila.ativa;
+}
+
+void GPIO_LCD_get_stats(GPIO_LCD_stats_t *out) {
+    uint32_t primask = util_irq_desativa();
+    *out = lcd_fila.stats;
+    out->depth = (uint8_t)(lcd_fila.head - lcd_fila.tail);
+    util_irq_restaura(primask);
+}
+
+void GPIO_LCD_display_stats(void) {
+    GPIO_LCD_stats_t s;
+    // "FILA  12 max  32" e "env 1234567 c  3"
+    char line_fila[17] = "FILA     max    ";
+    char line_env[17] = "env         c   ";
+
+    GPIO_LCD_get_stats(&s);
+    util_formata(s.depth, line_fila + 5, 3);
+    util_formata(s.max_depth, line_fila + 13, 3);
+    util_formata(s.bytes < 10000000 ? s.bytes : 9999999, line_env + 4, 7);
+    util_formata(s.full < 1000 ? s.full : 999, line_env + 13, 3);
+    GPIO_LCD_escreve_buffer(0x00, (uint8_t *)line_fila);
+    GPIO_LCD_escreve_buffer(0x40, (uint8_t *)line_env);
 }
 
 void GPIO_LCD_init() {
-    espera_2us(15000);  // espera por mais de 30ms: 30000us/2 = 15000
+    uint8_t i, j;
+
+    lcd_calibra();
+    delay_us(30000);  // espera por mais de 30ms
+
+    GPIO_LCD_set_RS(COMANDO);
+    GPIO_LCD_escreve_byte(0x38, 39);    // Function Set: 39us
+    GPIO_LCD_escreve_byte(0x0C, 39);    // Display ON/OFF Control: 39us
+    GPIO_LCD_escreve_byte(0x01, 1530);  // Display Clear: 1530us
+    GPIO_LCD_escreve_byte(0x06, 39);    //!< Entry mode set: 39us
 
+    // Caracteres customizados: Set CGRAM Address 0 e os 8 bytes de cada um em sequencia
+    GPIO_LCD_escreve_byte(0x40, 39);
+    GPIO_LCD_set_RS(DADO);
+    for (i = 0; i < LCD_N_GLIFOS; i++) {
+        for (j = 0; j < 8; j++) {
+            GPIO_LCD_escreve_byte(lcd_glifos[i][j], 43);
+        }
+    }
     GPIO_LCD_set_RS(COMANDO);
-    GPIO_LCD_escreve_byte(0x38, 20);   // Function Set: 39us/2 = 20
-    GPIO_LCD_escreve_byte(0x0C, 20);   // Display ON/OFF Control: 39us/2 = 20
-    GPIO_LCD_escreve_byte(0x01, 765);  // Display Clear: 1530us/2 = 765
-    GPIO_LCD_escreve_byte(0x06, 20);   //!< Entry mode set: 39us/2 = 20
+    GPIO_LCD_escreve_byte(0x80, 39);  // volta a escrita para a DDRAM, endereco 0
+
+    // Display Clear preencheu a DDRAM com espacos; o endereco esta em 0
+    for (i = 0; i < LCD_LINHAS; i++) {
+        for (j = 0; j < LCD_COLUNAS; j++) {
+            lcd_buffer[i][j] = ' ';
+            lcd_ddram[i][j] = ' ';
+        }
+    }
+    lcd_cursor = 0x00;
 }
 
 void GPIO_LCD_escreve_string(uint8_t end, uint8_t* str) {
-    // Codifica o endereco na instrucao "Set DDRAM Address".
-    uint8_t tmp = 0b10000000 | end;
+    // so espera se a fila estiver cheia; os tempos de 39us/43us ficam com o PIT
+    while (!GPIO_LCD_enfileira_string(end, str)) {
+    }
+}
+
+void GPIO_LCD_escreve_buffer(uint8_t end, const uint8_t *str) {
+    uint8_t linha = (end >> 6) & 0x1, coluna = end & 0x3F;
+
+    while (*str != '\0' && coluna < LCD_COLUNAS) {
+        lcd_buffer[linha][coluna++] = *str++;
+    }
+}
+
+uint8_t GPIO_LCD_atualiza(void) {
+    uint8_t linha, coluna, end, bytes = 0;
+
+    for (linha = 0; linha < LCD_LINHAS; linha++) {
+        for (coluna = 0; coluna < LCD_COLUNAS; coluna++) {
+            if (lcd_buffer[linha][coluna] == lcd_ddram[linha][coluna]) {
+                continue;
+            }
+            if (lcd_livre() < 2) {
+                // fila cheia: o restante fica para a proxima chamada
+                lcd_fila.stats.full++;
+                lcd_dispara();
+                return bytes;
+            }
+            end = lcd_endereco(linha, coluna);
+            if (lcd_cursor != end) {
+                // inicio de um trecho alterado: Set DDRAM Address
+                lcd_empilha(0b10000000 | end, COMANDO);
+                bytes++;
+            }
+            lcd_empilha(lcd_buffer[linha][coluna], DADO);
+            lcd_ddram[linha][coluna] = lcd_buffer[linha][coluna];
+            lcd_cursor = end + 1;
+            bytes++;
+        }
+    }
+    if (bytes) {
+        lcd_dispara();
+    }
+    return bytes;
+}
+
+/**
+ * @brief Ciclos do nucleo gastos por um caminho para colocar LCD_BENCH_N bytes no barramento
+ *
+ * Envia Entry Mode Set (o mesmo de GPIO_LCD_init()), que nao altera a tela
+ */
+static uint32_t lcd_bench_caminho(void (*pulsa)(uint8_t)) {
+    uint32_t primask, t0, ciclos = 0, i;
 
-    // Seta end no registrador de endereco de DDRAM por um tempo de processamento
-    //  maior que 39us (39/2 = 20)
     GPIO_LCD_set_RS(COMANDO);
-    GPIO_LCD_escreve_byte(tmp, 20);
+    for (i = 0; i < LCD_BENCH_N; i++) {
+        primask = util_irq_desativa();
+        t0 = SysTick_getCycles32();
+        pulsa(0x06);
+        ciclos += SysTick_getCycles32() - t0;
+        util_irq_restaura(primask);
+        delay_us(39);
+    }
+    return ciclos;
+}
 
-    // Grava os caracteres da Tabela de Fontes a partir do endereco setado.
-    // O tempo de escrita de cada byte eh maior que 43us (43/2 = 22)
-    GPIO_LCD_set_RS(DADO);
-    while (*str != '\0') {
-        GPIO_LCD_escreve_byte(*str, 22);
-        str++;
+void GPIO_LCD_bench(GPIO_LCD_bench_t *out) {
+    // fila parada: o barramento eh usado diretamente
+    while (!GPIO_LCD_fila_vazia()) {
     }
+    out->ciclos_ponte = lcd_bench_caminho(lcd_pulsa_ponte) / LCD_BENCH_N;
+    out->ciclos_ioport = lcd_bench_caminho(lcd_pulsa_ioport) / LCD_BENCH_N;
+    out->e_ns = lcd_e_voltas * 3 * 1000 / (clock_get()->core / 1000000);
+}
+
+void GPIO_LCD_bench_run(void) {
+    GPIO_LCD_bench_t result;
+    // "ponte   54 cic/B" e "ioport  31 cic/B"
+    char line_ponte[17] = "ponte      cic/B";
+    char line_ioport[17] = "ioport     cic/B";
+
+    GPIO_LCD_bench(&result);
+    util_formata(result.ciclos_ponte, line_ponte + 7, 4);
+    util_formata(result.ciclos_ioport, line_ioport + 7, 4);
+    GPIO_LCD_escreve_string(0x00, (uint8_t *)line_ponte);
+    GPIO_LCD_escreve_string(0x40, (uint8_t *)line_ioport);
 }
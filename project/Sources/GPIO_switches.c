@@ -7,36 +7,34 @@
  * @author João Pedro Souza Pascon
  */
 
+#include "bme.h"
 #include "mcu.h"
 #include "util.h"
 
 void GPIO_switches_init(uint8_t prioridade) {
     // Habilita o clock do modulo PORTA para botoeiras
-    SIM_SCGC5 |= SIM_SCGC5_PORTA_MASK;
+    bme_or32(&SIM_SCGC5, SIM_SCGC5_PORTA_MASK);
 
     // Funcao GPIO
     // Muda modo de multiplexacao para GPIO para contornar interrupcoes indesejaveis
-    // limpar os bits 8:10
-    PORTA_PCR4 &= ~PORT_PCR_MUX(0x7);
-    PORTA_PCR5 &= ~PORT_PCR_MUX(0x7);
-    PORTA_PCR12 &= ~PORT_PCR_MUX(0x7);
-    // setar alternativa 1
-    PORTA_PCR4 |= PORT_PCR_MUX(0x1);
-    PORTA_PCR5 |= PORT_PCR_MUX(0x1);
-    PORTA_PCR12 |= PORT_PCR_MUX(0x1);
+    // bits 8:10 com a alternativa 1
+    bme_bfi32(&PORTA_PCR4, PORT_PCR_MUX_SHIFT, 3, 0x1);
+    bme_bfi32(&PORTA_PCR5, PORT_PCR_MUX_SHIFT, 3, 0x1);
+    bme_bfi32(&PORTA_PCR12, PORT_PCR_MUX_SHIFT, 3, 0x1);
+    // filtro passivo de entrada (corta pulsos curtos do repique)
+    bme_or32(&PORTA_PCR4, PORT_PCR_PFE_MASK);
+    bme_or32(&PORTA_PCR5, PORT_PCR_PFE_MASK);
+    bme_or32(&PORTA_PCR12, PORT_PCR_PFE_MASK);
 
     // Sentido do sinal: entrada
-    GPIOA_PDDR &= ~(GPIO_PIN(4) | GPIO_PIN(5) | GPIO_PIN(12));
+    bme_and32(&GPIOA_PDDR, ~(GPIO_PIN(4) | GPIO_PIN(5) | GPIO_PIN(12)));
 
     // Configura modo de interrupcao para pinos PTA4, PTA5 e PTA12
-    // limpar os bits 16:19
-    PORTA_PCR4 &= ~PORT_PCR_IRQC(0xF);
-    PORTA_PCR5 &= ~PORT_PCR_IRQC(0xF);
-    PORTA_PCR12 &= ~PORT_PCR_IRQC(0xF);
-    // limpa flag de interrupcao + configura evento de interrupcao
-    // PORTA_PCR4 |= PORT_PCR_ISF_MASK | PORT_PCR_IRQC(NMI_IRQC);      // modo de interrupcao
-    // PORTA_PCR5 |= PORT_PCR_ISF_MASK | PORT_PCR_IRQC(IRQA5_IRQC);    // modo de interrupcao
-    // PORTA_PCR12 |= PORT_PCR_ISF_MASK | PORT_PCR_IRQC(IRQA12_IRQC);  // modo de interrupcao
+    // limpa flag de interrupcao + interrupcao nas duas bordas (bits 16:19), sempre habilitada:
+    // repiques e pressionamentos fora de hora sao filtrados em software (input.h)
+    GPIO_switches_IRQAn_interrupt_ativa(4, BTN_IRQC);
+    GPIO_switches_IRQAn_interrupt_ativa(5, BTN_IRQC);
+    GPIO_switches_IRQAn_interrupt_ativa(12, BTN_IRQC);
 
     /**
      * Configura o modulo NVIC: habilita IRQ 30 e limpa pendencias IRQ 30
@@ -54,9 +52,10 @@ void GPIO_switches_init(uint8_t prioridade) {
 }
 
 void GPIO_switches_IRQAn_interrupt_desativa(uint8_t n) {
-    PORT_PCR_REG(PORTA_BASE_PTR, n) &= ~(PORT_PCR_ISF_MASK | PORT_PCR_IRQC(0b1111));
+    bme_and32(&PORT_PCR_REG(PORTA_BASE_PTR, n), ~(PORT_PCR_ISF_MASK | PORT_PCR_IRQC(0b1111)));
 }
 
 void GPIO_switches_IRQAn_interrupt_ativa(uint8_t n, uint8_t IRQC) {
-    PORT_PCR_REG(PORTA_BASE_PTR, n) |= PORT_PCR_ISF_MASK | PORT_PCR_IRQC(IRQC);
+    bme_or32(&PORT_PCR_REG(PORTA_BASE_PTR, n), PORT_PCR_ISF_MASK);  // w1c: limpa flag pendente
+    bme_bfi32(&PORT_PCR_REG(PORTA_BASE_PTR, n), PORT_PCR_IRQC_SHIFT, 4, IRQC);
 }
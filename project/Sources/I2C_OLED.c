@@ -9,6 +9,8 @@
 
 #include "I2C_OLED.h"
 
+#include "periph.h"
+
 #include "I2C.h"
 #include "string.h"
 
@@ -56,10 +58,11 @@ static uint8_t scrbuf_cmd[SCRBUF_CMD_SIZE] = {
 };
 static uint8_t *const scrbuf = scrbuf_cmd + 1;
 
-void I2C_initConSSD1306(void) {
+void I2C_initConSSD1306(uint8_t icr) {
     /*
      * Initialize module I2C2 for connection
-     * Default bus clock frequency is 20971520 (47,68ns)
+     * I2C0 is clocked by the bus clock; icr comes from the clock profile (clock.h)
+     * Example for a 20971520 bus clock (47,68ns)
      * SSD1306 controller (display OLED) specifications
      * (https://datasheethub.com/wp-content/uploads/2022/08/SSD1306.pdf)
      * baud rate < 400000Hz; Typical value = 115200Hz; Used: 100kHz
@@ -70,7 +73,7 @@ void I2C_initConSSD1306(void) {
      * SCL stop hold time = tSSTOP = 0.6us -> SCL stop hold value = 600/(47,68*1) = 12,58
      * ICR = 0x22
      */
-    I2C_Init(0, ALT1, MULT0, 0x22);
+    periph_i2c_init(OLED_I2C, OLED_I2C_ALT, OLED_I2C_MULT, icr);
 }
 /****************************************************************************************
  *
@@ -89,10 +92,10 @@ void I2C_OLED_redisplay(void) {
     tmp = update_cmds;
     for (i = sizeof(update_cmds); i; i--, tmp++) {
         v[1] = *tmp;
-        I2C_WriteMultData(0, SSD1306_I2C, 2, v);
+        periph_i2c_write(OLED_I2C, SSD1306_I2C, 2, v);
     }
 
-    I2C_WriteMultData(0, SSD1306_I2C, SCRBUF_CMD_SIZE, scrbuf_cmd);
+    periph_i2c_write(OLED_I2C, SSD1306_I2C, SCRBUF_CMD_SIZE, scrbuf_cmd);
 }
 /****************************************************************************************
  *
@@ -109,7 +112,7 @@ void I2C_initOLED(void) {
 
     for (i = sizeof(init_cmds); i; i--, tmp++) {
         v[1] = *tmp;
-        I2C_WriteMultData(0, SSD1306_I2C, 2, v);
+        periph_i2c_write(OLED_I2C, SSD1306_I2C, 2, v);
     }
 
     // Fill the screenbuffer
@@ -9,68 +9,60 @@
 
 #include "ISR.h"
 
+#include "input.h"
 #include "mcu.h"
+#include "swtimer.h"
 #include "util.h"
 
-static state_t state;
 static player_t player = PLAYER_1;
 static board_t board;
 
-void FTM1_IRQHandler() {
-    static uint16_t tempo = 0;
-    uint16_t valor;
+void SysTick_Handler() {
+    SysTick_tick();
+    swtimer_tick();
+}
 
-    // TOF
-    if (TPM1_SC & TPM_SC_TOIE_MASK && TPM1_STATUS & (TPM_STATUS_TOF_MASK)) {
-        if (tempo == 0) {
-            valor = (uint16_t)((0.003405 * 20971520) / 128);  // seta nova nota
-            TPM_setaMOD(1, valor);
-            TPM_setaCnV(1, 1, (uint16_t)(valor * 0.5));  // amplitude: 1/2 potencia
-        }
-        if (tempo < 50) {
-            tempo++;
-        } else {
-            TPM_setaMOD(1, 0);
-            TPM_setaCnV(1, 1, 0);
-            tempo = 0;
-            TPM_desabilitaInterrupTOF(1);
-        }
-        TPM1_SC |= TPM_SC_TOF_MASK;
+void PORTA_IRQHandler() {
+    // so filtra e enfileira: os eventos sao tratados pelo passo da fisica ou pela tarefa de controle
+    uint32_t t = SysTick_getCycles32();
+    uint32_t isf = PORTA_ISFR;
+    uint32_t level = GPIOA_PDIR;
+
+    PORTA_ISFR = isf;  // w1c: limpa as flags lidas
+    if (isf & GPIO_PIN(4)) {
+        input_edge(4, t, !(level & GPIO_PIN(4)));
+    }
+    if (isf & GPIO_PIN(5)) {
+        input_edge(5, t, !(level & GPIO_PIN(5)));
+    }
+    if (isf & GPIO_PIN(12)) {
+        input_edge(12, t, !(level & GPIO_PIN(12)));
     }
 }
 
-void PORTA_IRQHandler() {
-    if (PORTA_PCR4 & PORT_PCR_ISF_MASK) {
-        if (state == PLAYER_TURN && player == PLAYER_1) {
-            TPM_habilitaInterrupTOF(1);  // play hit sound
-            GPIO_switches_IRQAn_interrupt_desativa(4);
-            board_hit_ball(&board);
-            ISR_swapPlayer();
-        }
-        PORTA_PCR4 |= PORT_PCR_ISF_MASK;  // w1c: limpa flag de interrupcao
-    } else if (PORTA_PCR5 & PORT_PCR_ISF_MASK) {
-        if (state == PLAYER_TURN && player == PLAYER_2) {
-            TPM_habilitaInterrupTOF(1);  // play hit sound
-            GPIO_switches_IRQAn_interrupt_desativa(5);
-            board_hit_ball(&board);
-            ISR_swapPlayer();
+void PIT_IRQHandler() {
+    input_event_t ev;
+
+    if (PIT_limpaFlag(0)) {
+        // rebatidas aplicadas antes de mover a bola, no instante da borda; o resto eh descartado
+        while (input_pop(&ev)) {
+            if (game_state() == PLAYER_TURN) {
+                game_play_input(&board, &ev);
+            }
         }
-        PORTA_PCR5 |= PORT_PCR_ISF_MASK;  // w1c: limpa flag de interrupcao
-    } else if (PORTA_PCR12 & PORT_PCR_ISF_MASK) {
-        if (state == INICIO) {
-            GPIO_switches_IRQAn_interrupt_desativa(12);
-            state = LAUNCH_BALL;
+        if (game_state() == PLAYER_TURN) {
+            game_physics_tick(&board);
         }
-        PORTA_PCR12 |= PORT_PCR_ISF_MASK;  // w1c: limpa flag de interrupcao
+    }
+    if (PIT_limpaFlag(1)) {
+        // fila do LCD: tempo de processamento do ultimo byte esgotado
+        GPIO_LCD_fila_isr();
     }
 }
 
-void ISR_setState(state_t s) {
-    state = s;
-}
-
-state_t ISR_getState(void) {
-    return state;
+void LPTimer_IRQHandler() {
+    // despertar de VLPS: o tempo dormido eh contabilizado por power_idle()
+    LPTMR0_CSR |= LPTMR_CSR_TCF_MASK;  // w1c: limpa flag de interrupcao
 }
 
 void ISR_setPlayer(player_t p) {
@@ -0,0 +1,55 @@
+/**
+ * @file PIT.c
+ * @brief Definicao das funcoes do PIT (temporizadores periodicos)
+ * @date 2026-10-19
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ */
+
+#include "PIT.h"
+
+#include "mcu.h"
+
+void PIT_init(uint8_t prioridade) {
+    SIM_SCGC6 |= SIM_SCGC6_PIT_MASK;  // habilita sinal de relogio
+
+    PIT_MCR = PIT_MCR_FRZ_MASK;  // MDIS = 0: liga o modulo; para durante a depuracao
+
+    /**
+     * Configura o modulo NVIC: habilita IRQ 22, limpa pendencias e seta prioridade
+     * registrador NVIC_IPR5 (Tabela 3-7/p. 54 do Manual)
+     */
+    NVIC_ISER = NVIC_ISER_SETENA(1 << 22);
+    NVIC_ICPR = NVIC_ICPR_CLRPEND(1 << 22);
+    NVIC_IPR5 = (NVIC_IPR5 & ~NVIC_IP_PRI_22_MASK) | NVIC_IP_PRI_22(prioridade << 6);
+}
+
+void PIT_ativa(uint8_t canal, uint32_t periodo) {
+    PIT_TCTRL(canal) = 0;                        // desabilita durante a configuracao
+    PIT_LDVAL(canal) = PIT_LDVAL_TSV(periodo - 1);  // conta de periodo - 1 ate 0
+    PIT_TFLG(canal) = PIT_TFLG_TIF_MASK;          // w1c: limpa flag pendente
+    PIT_TCTRL(canal) = PIT_TCTRL_TIE_MASK | PIT_TCTRL_TEN_MASK;
+}
+
+void PIT_ativaLivre(uint8_t canal) {
+    PIT_TCTRL(canal) = 0;
+    PIT_LDVAL(canal) = PIT_LDVAL_TSV_MASK;  // maior periodo: ~400 s no barramento
+    PIT_TCTRL(canal) = PIT_TCTRL_TEN_MASK;
+}
+
+uint32_t PIT_leContagem(uint8_t canal) {
+    return PIT_CVAL(canal);
+}
+
+void PIT_desativa(uint8_t canal) {
+    PIT_TCTRL(canal) = 0;
+    PIT_TFLG(canal) = PIT_TFLG_TIF_MASK;
+}
+
+uint8_t PIT_limpaFlag(uint8_t canal) {
+    if (PIT_TFLG(canal) & PIT_TFLG_TIF_MASK) {
+        PIT_TFLG(canal) = PIT_TFLG_TIF_MASK;  // w1c
+        return 1;
+    }
+    return 0;
+}
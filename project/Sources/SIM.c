@@ -29,3 +29,43 @@ void SIM_setaFLLPLL(uint8_t pll) {
 void SIM_setaTPMSRC(uint8_t src) {
     SIM_SOPT2 |= SIM_SOPT2_TPMSRC(src);
 }
+
+uint32_t SIM_leCoreClock(void) {
+    // fator do FLL por DMX32 e DRST_DRS (Tabela 24-5 do Manual)
+    static const uint16_t fll_fator[2][4] = {{640, 1280, 1920, 2560}, {732, 1464, 2197, 2929}};
+    uint32_t mcgout, ref;
+
+    switch ((MCG_C1 & MCG_C1_CLKS_MASK) >> MCG_C1_CLKS_SHIFT) {
+        case 0b00:  // saida do FLL ou do PLL
+            if (MCG_C6 & MCG_C6_PLLS_MASK) {
+                mcgout = SIM_OSC_FREQ / ((MCG_C5 & MCG_C5_PRDIV0_MASK) + 1) * ((MCG_C6 & MCG_C6_VDIV0_MASK) + 24);
+            } else {
+                if (MCG_C1 & MCG_C1_IREFS_MASK) {
+                    ref = SIM_IRC_SLOW;
+                } else {
+                    ref = SIM_OSC_FREQ >> ((MCG_C1 & MCG_C1_FRDIV_MASK) >> MCG_C1_FRDIV_SHIFT);
+                    if (MCG_C2 & MCG_C2_RANGE0_MASK) {
+                        ref /= 32;  // cristal de alta frequencia: divisor extra
+                    }
+                }
+                mcgout = ref * fll_fator[(MCG_C4 & MCG_C4_DMX32_MASK) ? 1 : 0]
+                                        [(MCG_C4 & MCG_C4_DRST_DRS_MASK) >> MCG_C4_DRST_DRS_SHIFT];
+            }
+            break;
+        case 0b01:  // referencia interna
+            if (MCG_C2 & MCG_C2_IRCS_MASK) {
+                mcgout = SIM_IRC_FAST >> ((MCG_SC & MCG_SC_FCRDIV_MASK) >> MCG_SC_FCRDIV_SHIFT);
+            } else {
+                mcgout = SIM_IRC_SLOW;
+            }
+            break;
+        default:  // referencia externa
+            mcgout = SIM_OSC_FREQ;
+            break;
+    }
+    return mcgout / (((SIM_CLKDIV1 & SIM_CLKDIV1_OUTDIV1_MASK) >> SIM_CLKDIV1_OUTDIV1_SHIFT) + 1);
+}
+
+uint32_t SIM_leBusClock(void) {
+    return SIM_leCoreClock() / (((SIM_CLKDIV1 & SIM_CLKDIV1_OUTDIV4_MASK) >> SIM_CLKDIV1_OUTDIV4_SHIFT) + 1);
+}
@@ -0,0 +1,72 @@
+/**
+ * @file SysTick.c
+ * @brief Definicao das funcoes do SysTick (base de tempo de 64 bits)
+ * @date 2026-10-19
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ */
+
+#include "SysTick.h"
+
+#include "mcu.h"
+#include "util.h"
+
+static uint32_t systick_period;
+static volatile uint64_t systick_ticks;  //!< estouros atendidos desde o ultimo SysTick_init()
+static uint64_t systick_base;            //!< ciclos contados ate o ultimo SysTick_init()
+
+void SysTick_init(uint32_t period, uint8_t prioridade) {
+    // reinicio (troca de relogio): a contagem continua de onde parou
+    systick_base = systick_period ? SysTick_getCycles() : 0;
+    systick_period = period;
+    systick_ticks = 0;
+
+    SYST_CSR = 0;                                  // desabilita durante a configuracao
+    SYST_RVR = SysTick_RVR_RELOAD(period - 1);     // conta de period - 1 ate 0
+    SYST_CVR = 0;                                  // qualquer escrita zera o contador
+    SCB_SHPR3 = (SCB_SHPR3 & ~SCB_SHPR3_PRI_15_MASK) | SCB_SHPR3_PRI_15(prioridade << 6);
+    SYST_CSR = SysTick_CSR_CLKSOURCE_MASK |  // relogio do nucleo
+               SysTick_CSR_TICKINT_MASK |    // interrupcao a cada estouro
+               SysTick_CSR_ENABLE_MASK;
+}
+
+void SysTick_tick(void) {
+    systick_ticks++;
+}
+
+uint64_t SysTick_getCycles(void) {
+    uint32_t primask, cvr;
+    uint64_t ticks;
+
+    // leitura atomica de (ticks, CVR)
+    primask = util_irq_desativa();
+    cvr = SYST_CVR;
+    ticks = systick_ticks;
+    if (SCB_ICSR & SCB_ICSR_PENDSTSET_MASK) {
+        // estourou e a ISR ainda nao rodou: CVR pode ter sido lido antes ou depois
+        // do estouro, entao le de novo (certamente depois) e conta o estouro pendente
+        cvr = SYST_CVR;
+        ticks++;
+    }
+    util_irq_restaura(primask);
+
+    // contador decrescente
+    return systick_base + ticks * systick_period + (systick_period - 1 - cvr);
+}
+
+uint32_t SysTick_getCycles32(void) {
+    uint32_t ticks, cvr, pend;
+
+    do {
+        ticks = (uint32_t)systick_ticks;
+        cvr = SYST_CVR;
+        pend = (SCB_ICSR & SCB_ICSR_PENDSTSET_MASK) ? 1 : 0;
+        if (pend) {
+            // estouro ainda nao atendido: le CVR de novo (certamente depois do estouro)
+            cvr = SYST_CVR;
+        }
+    } while (ticks != (uint32_t)systick_ticks);  // SysTick_Handler rodou: repete
+
+    // so os 32 bits baixos de ticks afetam o resultado modulo 2^32
+    return (uint32_t)systick_base + (ticks + pend) * systick_period + (systick_period - 1 - cvr);
+}
@@ -6,7 +6,9 @@
  * @date 26/01/2023
  */
 
+#include "bme.h"
 #include "mcu.h"
+#include "periph.h"
 
 static TPM_MemMapPtr TPM[] = TPM_BASE_PTRS;
 
@@ -14,16 +16,16 @@ void TPM_config_basica() {
     /**
      * Habilita os sinais de rel�gio para TPM1
      */
-    SIM_SCGC6 |= SIM_SCGC6_TPM1_MASK;
+    bme_or32(&SIM_SCGC6, SIM_SCGC6_TPM1_MASK);
 
     /**
      * Configura pinos PT
      */
-    SIM_SCGC5 |= SIM_SCGC5_PORTE_MASK;  // habilita sinais de relogio
+    bme_or32(&SIM_SCGC5, SIM_SCGC5_PORTE_MASK);  // habilita sinais de relogio
 
-    PORTE_PCR21 |= (PORT_PCR_ISF_MASK |  // TPM1_CH1
-                    PORT_PCR_MUX(0x3) |
-                    PORT_PCR_DSE_MASK);  // drive strength enable
+    bme_bfi32(&PORTE_PCR21, PORT_PCR_MUX_SHIFT, 3, 0x3);  // TPM1_CH1
+    bme_or32(&PORTE_PCR21, PORT_PCR_ISF_MASK |
+                               PORT_PCR_DSE_MASK);  // drive strength enable
     // e.g. 18 mA vs. 5 mA @ > 2.7 V,
 
     return;
@@ -38,11 +40,11 @@ void TPM_config_especifica(uint8_t x, uint16_t mod, uint8_t trigger, uint8_t cro
 
     if (temp != 0b0010 && temp != 0b0011 && temp != 0b0110 &&
         temp != 0b0111 && temp != 0b1011 && temp != 0b1111) {
-        TPM[x]->CONF &= ~((0b1111 << 24) | (0b111 << 16));
-        TPM[x]->CONF |= TPM_CONF_TRGSEL(trigger);      // Tabela 3-38/p. 86
-        if (crot) TPM[x]->CONF |= TPM_CONF_CROT_MASK;  // Resetar CNT no disparo
-        if (csoo) TPM[x]->CONF |= TPM_CONF_CSOO_MASK;  // CNT para em TOF
-        if (csot) TPM[x]->CONF |= TPM_CONF_CSOT_MASK;  // Ativar contador no disparo
+        bme_bfi32(&TPM[x]->CONF, TPM_CONF_TRGSEL_SHIFT, 4, trigger);  // Tabela 3-38/p. 86
+        bme_bfi32(&TPM[x]->CONF, TPM_CONF_CSOT_SHIFT, 3,
+                  (csot ? 1 : 0) |        // Ativar contador no disparo
+                  (csoo ? 1 : 0) << 1 |   // CNT para em TOF
+                  (crot ? 1 : 0) << 2);   // Resetar CNT no disparo
     }
     /**
      * Resetar o contador fazendo um acesso de escrita
@@ -52,17 +54,16 @@ void TPM_config_especifica(uint8_t x, uint16_t mod, uint8_t trigger, uint8_t cro
     /**
      * Configurar periodo do contador T = PS*MOD/freq.
      */
-    TPM[x]->SC &= ~TPM_SC_PS(0b111);
-    TPM[x]->SC |= TPM_SC_PS(ps);
-    if (dma) TPM[x]->SC |= TPM_SC_DMA_MASK;
-    if (cpwms) TPM[x]->SC |= TPM_SC_CPWMS_MASK;
+    bme_bfi32(&TPM[x]->SC, TPM_SC_PS_SHIFT, 3, ps);
+    if (dma) bme_or32(&TPM[x]->SC, TPM_SC_DMA_MASK);
+    if (cpwms) bme_or32(&TPM[x]->SC, TPM_SC_CPWMS_MASK);
 
     /**
      * Configurar a contagem maxima
      */
     TPM[x]->MOD = TPM_MOD_MOD(mod);
 
-    TPM[x]->SC |= TPM_SC_CMOD(1);  // ativar o contador LPTPM
+    bme_or32(&TPM[x]->SC, TPM_SC_CMOD(1));  // ativar o contador LPTPM
     return;
 }
 
@@ -70,8 +71,7 @@ void TPM_CH_config_especifica(uint8_t x, uint8_t n, uint8_t MS_ELS, uint16_t val
     /**
      * Configurar o modo de operacao do canal
      */
-    TPM[x]->CONTROLS[n].CnSC &= ~(0b1111 << 2);
-    TPM[x]->CONTROLS[n].CnSC |= (MS_ELS << 2);
+    bme_bfi32(&TPM[x]->CONTROLS[n].CnSC, TPM_CnSC_ELSA_SHIFT, 4, MS_ELS);  // MSB:MSA:ELSB:ELSA
 
     /**
      * Inicializar com valor 0 no contador
@@ -103,18 +103,18 @@ void TPM_habilitaNVICIRQ(uint8_t irq, uint8_t prioridade) {
 }
 
 void TPM_habilitaInterrupTOF(uint8_t x) {
-    TPM[x]->SC |= (TPM_SC_TOF_MASK |   // resetar flag
-                   TPM_SC_TOIE_MASK);  // habilitar a interrupcao TOF
+    bme_or32(&TPM[x]->SC, TPM_SC_TOF_MASK |    // resetar flag
+                              TPM_SC_TOIE_MASK);  // habilitar a interrupcao TOF
 }
 
 void TPM_desabilitaInterrupTOF(uint8_t x) {
-    TPM[x]->SC &= ~TPM_SC_TOIE_MASK;  // habilitar a interrupcao TOF
+    bme_and32(&TPM[x]->SC, ~TPM_SC_TOIE_MASK);  // desabilitar a interrupcao TOF
 }
 
 void TPM_setaMOD(uint8_t x, uint16_t mod) {
-    TPM[x]->MOD = TPM_MOD_MOD(mod);
+    periph_tpm_set_mod(x, mod);
 }
 
 void TPM_setaCnV(uint8_t x, uint8_t n, uint16_t valor) {
-    TPM[x]->CONTROLS[n].CnV = TPM_CnV_VAL(valor);
+    periph_tpm_set_cnv(x, n, valor);
 }
@@ -0,0 +1,188 @@
+/**
+ * @file ai.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Jogador controlado pelo microcontrolador
+ * @date 2026-10-19
+ */
+
+#include "ai.h"
+
+#include <math.h>
+
+const ai_params_t ai_default_params = {
+    .reaction_ms = AI_REACTION_MS,
+    .error_ms = AI_ERROR_MS,
+    .reach = AI_REACH,
+};
+
+/**
+ * @brief Tempo ate a bola chegar ao chao: y + vy * t + g * t^2 / 2 = FLOOR_LEVEL - 1
+ */
+static float ai_time_to_floor(float y, float vy, float g) {
+    float h = (FLOOR_LEVEL - 1) - y;
+    if (h < 0) {
+        h = 0;
+    }
+    return (sqrtf(vy * vy + 2 * g * h) - vy) / g;
+}
+
+/**
+ * @brief Verifica se rebater a bola no estado "ball" a devolve por cima da rede e dentro da quadra
+ */
+static uint8_t ai_return_is_safe(const board_t *ball) {
+    board_t hit = *ball;
+    const float g = ball->params->g;
+    const float edges[2] = {SCREEN_WIDTH / 2 - 5, SCREEN_WIDTH / 2 + 5};
+    float t_edge, y_edge, x_land;
+    uint8_t i;
+
+    board_hit_ball(&hit);
+    // board_update() so troca o lado da bola se ela passa por cima de toda a faixa
+    // do meio (rede +- 5 pixels); a parabola eh convexa, entao basta a altura nas
+    // duas bordas da faixa (y cresce para baixo)
+    for (i = 0; i < 2; i++) {
+        t_edge = (edges[i] - hit.ball_pos.x) / hit.ball_vel.x;
+        y_edge = hit.ball_pos.y + hit.ball_vel.y * t_edge + g * t_edge * t_edge / 2;
+        if (t_edge < 0 || y_edge > NET_TOP - AI_NET_MARGIN) {
+            return 0;
+        }
+    }
+    // depois do apice a bola so desce: se passou da faixa, o primeiro quique eh do outro lado
+    x_land = hit.ball_pos.x + hit.ball_vel.x * ai_time_to_floor(hit.ball_pos.y, hit.ball_vel.y, g);
+    return x_land > 0 && x_land < SCREEN_WIDTH;
+}
+
+void ai_init(ai_t *ai, player_t player, const ai_params_t *params, prng_t *rng) {
+    ai->player = player;
+    ai->params = params;
+    ai->rng = rng;
+    ai->dt = 0;
+    ai_reset(ai);
+}
+
+void ai_reset(ai_t *ai) {
+    ai->state = AI_WAITING;
+    ai->elapsed = 0;
+    ai->error = 0;
+    ai->countdown = 0;
+}
+
+uint8_t ai_predict(const board_t *board, player_t player, float reach, ai_prediction_t *pred) {
+    const board_params_t *p = board->params;
+    float x = board->ball_pos.x, y = board->ball_pos.y, vx = board->ball_vel.x, vy = board->ball_vel.y;
+    float baseline = player == PLAYER_1 ? 0 : SCREEN_WIDTH;
+    float t_base, t_floor1, t_floor2, vy_bounce, t, tau, best = -1;
+    uint8_t bounces = player == PLAYER_1 ? board->bounces_left : board->bounces_right, i;
+    board_t ball = *board;
+
+    if ((player == PLAYER_1 && vx >= 0) || (player == PLAYER_2 && vx <= 0)) {
+        // bola se afastando
+        return 0;
+    }
+
+    // x(t) = x + vx * t
+    t_base = (baseline - x) / vx;
+    pred->t_reach = (baseline + (player == PLAYER_1 ? reach : -reach) - x) / vx;
+    if (pred->t_reach < 0) {
+        pred->t_reach = 0;
+    }
+
+    // proximo quique; depois dele a bola sobe com restitution * vy e volta ao chao em 2 * vy / g
+    t_floor1 = ai_time_to_floor(y, vy, p->g);
+    vy_bounce = -p->restitution * (vy + p->g * t_floor1);
+    t_floor2 = t_floor1 - 2 * vy_bounce / p->g;
+
+    pred->x_landing = x + vx * t_floor1;
+    pred->out = bounces == 0 && t_base < t_floor1;
+    if (bounces == 0) {
+        pred->t_deadline = t_base < t_floor2 ? t_base : t_floor2;
+    } else {
+        pred->t_deadline = t_base < t_floor1 ? t_base : t_floor1;
+    }
+
+    // candidatos em [0, t_deadline): estado da bola em forma fechada
+    pred->t_hit = pred->t_reach < pred->t_deadline ? pred->t_reach : pred->t_deadline;
+    pred->safe = 0;
+    for (i = 0; i < AI_CANDIDATES; i++) {
+        t = pred->t_deadline * i / AI_CANDIDATES;
+        ball.ball_pos.x = x + vx * t;
+        if (t < t_floor1) {
+            ball.ball_pos.y = y + vy * t + p->g * t * t / 2;
+            ball.ball_vel.y = vy + p->g * t;
+        } else {
+            tau = t - t_floor1;
+            ball.ball_pos.y = (FLOOR_LEVEL - 1) + vy_bounce * tau + p->g * tau * tau / 2;
+            ball.ball_vel.y = vy_bounce + p->g * tau;
+        }
+        if (!ai_return_is_safe(&ball)) {
+            continue;
+        }
+        if (best < 0) {
+            pred->t_safe_first = t;
+        }
+        pred->t_safe_last = t;
+        if (best < 0 || fabsf(t - pred->t_reach) < fabsf(best - pred->t_reach)) {
+            best = t;
+        }
+    }
+    if (best >= 0) {
+        pred->t_hit = best;
+        pred->safe = 1;
+    }
+    return 1;
+}
+
+uint8_t ai_update(ai_t *ai, const board_t *board, uint32_t dt) {
+    region_t side = ai->player == PLAYER_1 ? LEFT : RIGHT;
+    ai_prediction_t pred;
+
+    ai->dt = dt / 1000.0f;
+    if (board->region != side) {
+        ai->state = AI_WAITING;
+        return 0;
+    }
+    switch (ai->state) {
+        case AI_WAITING:
+            // bola acabou de entrar no seu lado: sorteia o erro desta rebatida
+            ai->state = AI_REACTING;
+            ai->elapsed = 0;
+            ai->error = prng_float(ai->rng, -ai->params->error_ms, ai->params->error_ms);
+            return 0;
+        case AI_REACTING:
+            ai->elapsed += ai->dt;
+            if (ai->elapsed < ai->params->reaction_ms) {
+                return 0;
+            }
+            // unica previsao desta passagem da bola
+            if (!ai_predict(board, ai->player, ai->params->reach, &pred) || pred.out) {
+                // bola se afastando ou saindo direto: deixa passar
+                ai->state = AI_DONE;
+                return 0;
+            }
+            ai->countdown = pred.t_hit + ai->error;
+            if (pred.safe) {
+                // o erro nao tira a rebatida da janela em que a devolucao passa pela rede
+                if (ai->countdown < pred.t_safe_first) {
+                    ai->countdown = pred.t_safe_first;
+                } else if (ai->countdown > pred.t_safe_last) {
+                    ai->countdown = pred.t_safe_last;
+                }
+            }
+            ai->state = AI_TRACKING;
+            break;
+        case AI_TRACKING:
+            // depois da previsao so desconta o tempo
+            ai->countdown -= ai->dt;
+            break;
+        case AI_DONE:
+        default:
+            return 0;
+    }
+    // rebate no quadro mais proximo do instante previsto
+    if (ai->countdown > ai->dt / 2) {
+        return 0;
+    }
+    ai->state = AI_DONE;
+    return 1;
+}
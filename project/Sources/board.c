@@ -0,0 +1,200 @@
+/**
+ * @file board.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Nucleo do jogo: fisica da bola e contagem do placar
+ *
+ * Nao acessa perifericos: o controle dos botoes e dos displays fica em game.c
+ *
+ * @date 2026-10-19
+ */
+
+#include "board.h"
+
+const board_params_t board_default_params = {
+    .g = G,
+    .v0 = V0,
+    .restitution = RESTITUTION,
+    .hit_mult = HIT_MULT,
+    .serve_spread = SERVE_SPREAD,
+    .serve_vy = SERVE_VY,
+};
+
+void board_reset(board_t *board) {
+    board->ball_pos.x = 0;
+    board->ball_pos.y = 0;
+    board->ball_vel.x = 0;
+    board->ball_vel.y = 0;
+    board->score[0].sets = 0;
+    board->score[1].sets = 0;
+    board->score[0].games = 0;
+    board->score[1].games = 0;
+    board->score[0].points = 0;
+    board->score[1].points = 0;
+    board->bounces_left = 0;
+    board->bounces_right = 0;
+    board->region = MIDDLE;
+    board->params = &board_default_params;
+}
+
+void board_update(board_t *board, uint32_t dt_us) {
+    const board_params_t *p = board->params;
+    const float dt = dt_us / 1000.0f;  // constantes fisicas em ms
+    float x_prev = board->ball_pos.x, y_prev = board->ball_pos.y;
+
+    // x_{k} = x_{k-1} + vx * dt
+    board->ball_pos.x += board->ball_vel.x * dt;
+    // S2 = S1 + V*t + a*t^2/2
+    board->ball_pos.y += board->ball_vel.y * dt + p->g * dt * dt / 2;
+    // vy_{k} = vy_{k-1} + g * dt
+    board->ball_vel.y += p->g * dt;
+
+    if (board->ball_pos.y >= FLOOR_LEVEL - 1 && board->ball_vel.y > 0) {
+        // acertou o chao: quica
+        board->ball_pos.y = FLOOR_LEVEL - 1;
+        board->ball_vel.y *= -p->restitution;
+        if (board->ball_pos.x < SCREEN_WIDTH / 2) {
+            board->bounces_left++;
+        } else {
+            board->bounces_right++;
+        }
+    }
+
+    if (y_prev >= NET_TOP || board->ball_pos.y >= NET_TOP) {
+        // acertou a rede: reflete
+        if (board->ball_pos.x >= NET_LEFT && board->ball_pos.x <= NET_RIGHT) {
+            board->ball_vel.x *= -p->restitution;
+        } else if (x_prev < SCREEN_WIDTH / 2 && board->ball_pos.x > SCREEN_WIDTH / 2) {
+            // acertou da esquerda
+            board->ball_vel.x *= -p->restitution;
+            board->ball_pos.x = NET_LEFT;
+        } else if (x_prev > SCREEN_WIDTH / 2 && board->ball_pos.x < SCREEN_WIDTH / 2) {
+            // acertou da direita
+            board->ball_vel.x *= -p->restitution;
+            board->ball_pos.x = NET_RIGHT;
+        }
+    } else {
+        // passou por cima da rede: reseta bounces e registra de que lado a bola esta
+        if (board->region != MIDDLE && board->ball_pos.x > SCREEN_WIDTH / 2 - 5 && board->ball_pos.x < SCREEN_WIDTH / 2 + 5) {
+            // bola no meio
+            board->region = MIDDLE;
+        } else if (board->region == MIDDLE && board->ball_pos.x > SCREEN_WIDTH / 2 + 5) {
+            // passou da esquerda para a direita
+            board->region = RIGHT;
+            board->bounces_right = 0;
+        } else if (board->region == MIDDLE && board->ball_pos.x < SCREEN_WIDTH / 2 - 5) {
+            // passou da direita para a esquerda
+            board->region = LEFT;
+            board->bounces_left = 0;
+        }
+    }
+}
+
+player_t board_check_winner_point(board_t *board) {
+    // IMPROV: take into consideration court dimensions
+    uint8_t ball_is_out = board->ball_pos.x < 0 || board->ball_pos.x >= SCREEN_WIDTH;
+    if (board->bounces_left > 1 || (board->bounces_left == 1 && (ball_is_out))) {
+        return PLAYER_2;
+    }
+    if (board->bounces_right > 1 || (board->bounces_right == 1 && (ball_is_out))) {
+        return PLAYER_1;
+    }
+    if (board->ball_pos.x < 0) {  // out from player 2
+        return PLAYER_1;
+    }
+    if (board->ball_pos.x >= SCREEN_WIDTH) {  // out from player 1
+        return PLAYER_2;
+    }
+    return PLAYER_NONE;
+}
+
+player_t board_check_winner_match(board_t *board, uint8_t sets_to_win) {
+    if (board->score[0].sets >= sets_to_win) {
+        return PLAYER_1;
+    }
+    if (board->score[1].sets >= sets_to_win) {
+        return PLAYER_2;
+    }
+    return PLAYER_NONE;
+}
+
+void board_reset_ball(board_t *board, prng_t *rng) {
+    const board_params_t *p = board->params;
+    float speed = p->v0 * prng_float(rng, 1 - p->serve_spread, 1 + p->serve_spread);
+    board->ball_pos.x = SCREEN_WIDTH / 2;
+    board->ball_pos.y = 8;
+    board->ball_vel.x = prng_next(rng) & 0x80000000u ? speed : -speed;
+    board->ball_vel.y = prng_float(rng, -p->serve_vy, p->serve_vy);
+    board->bounces_left = 0;
+    board->bounces_right = 0;
+}
+
+void board_hit_ball(board_t *board) {
+    float hit_mult = board->params->hit_mult;
+    // velocidade horizontal sempre aumenta
+    board->ball_vel.x *= -hit_mult;
+    if (board->ball_vel.y > 0) {
+        // bola caindo: reflete velocidade vertical
+        board->ball_vel.y *= -1;
+    } else {
+        // bola subindo: bola fica mais rapida
+        board->ball_vel.y *= hit_mult;
+    }
+}
+
+uint8_t board_score_point(board_t *board, player_t winner) {
+    if (winner != PLAYER_1 && winner != PLAYER_2) {
+        // ERROR
+        return 0;
+    }
+    uint8_t p_idx = ((uint8_t)winner) - 1;
+    switch (board->score[p_idx].points) {
+        case 0:
+            board->score[p_idx].points = 15;
+            break;
+        case 15:
+            board->score[p_idx].points = 30;
+            break;
+        case 30:
+            board->score[p_idx].points = 40;
+            break;
+        case 40:
+            if (board->score[(p_idx + 1) % 2].points == SCORE_AD) {
+                // adversario perde a vantagem: deuce
+                board->score[(p_idx + 1) % 2].points = 40;
+                break;
+            }
+            if (board->score[(p_idx + 1) % 2].points == 40) {
+                board->score[p_idx].points = SCORE_AD;
+                break;
+            }
+            // fall through
+        case SCORE_AD:
+            // player venceu game
+
+            // reseta pontos para proximo game
+            board->score[p_idx].points = 0;
+            board->score[(p_idx + 1) % 2].points = 0;
+
+            // atualiza numero de games
+            board->score[p_idx].games += 1;
+            return 1;
+        default:
+            break;
+    }
+    return 0;
+}
+
+uint8_t board_score_set(board_t *board, uint8_t games_to_set) {
+    uint8_t p_idx;
+    for (p_idx = 0; p_idx < 2; p_idx++) {
+        if (board->score[p_idx].games == games_to_set) {
+            // IMPROV: 2+ games diff
+            board->score[p_idx].games = 0;
+            board->score[(p_idx + 1) % 2].games = 0;
+            board->score[p_idx].sets += 1;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file board_batch.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Fisica em lote: mesmo passo de board_update() para n bolas independentes
+ *
+ * Os "if" de board_update() viram selecoes sobre mascaras calculadas a partir do
+ * estado da bola, na mesma ordem de avaliacao, para que o resultado seja identico
+ * ao da versao escalar.
+ *
+ * No host com SSE2/AVX/NEON as bolas sao processadas BATCH_LANES por vez com os
+ * vetores genericos do GCC (o auto-vetorizador nao consegue converter as selecoes
+ * encadeadas deste laco). No alvo, e para as bolas que sobram, usa-se o laco
+ * escalar board_batch_step().
+ *
+ * @date 2026-10-19
+ */
+
+#include "board_batch.h"
+
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON)) && !defined(BOARD_BATCH_NO_SIMD)
+#define BOARD_BATCH_SIMD
+#if defined(__AVX__)
+#define BATCH_LANES 8
+#else
+#define BATCH_LANES 4
+#endif
+
+typedef float vfloat_t __attribute__((vector_size(BATCH_LANES * 4)));
+typedef int32_t vint_t __attribute__((vector_size(BATCH_LANES * 4)));
+typedef uint8_t vbyte_t __attribute__((vector_size(BATCH_LANES)));
+
+// mascaras de comparacao valem -1 (verdadeiro) ou 0 (falso) em cada posicao
+#define VSELECT_F(m, a, b) ((vfloat_t)(((m) & (vint_t)(a)) | (~(m) & (vint_t)(b))))
+#define VSELECT_I(m, a, b) (((m) & (a)) | (~(m) & (b)))
+#endif
+
+/**
+ * @brief Passo da bola i (mesma sequencia de board_update())
+ */
+static inline void board_batch_step(board_batch_t *batch, uint32_t i, float dtf, float g_dt, float half_g_dt2,
+                                    float bounce) {
+    float *x = batch->x, *y = batch->y, *vx = batch->vx, *vy = batch->vy;
+    uint8_t *bl = batch->bounces_left, *br = batch->bounces_right, *reg = batch->region;
+    float x_prev = x[i], y_prev = y[i];
+    float xi = x_prev + vx[i] * dtf;
+    float yi = y_prev + (vy[i] * dtf + half_g_dt2);
+    float vxi = vx[i];
+    float vyi = vy[i] + g_dt;
+    uint8_t r = reg[i];
+    int floor_hit, net, net_mid, net_left, net_right, over, to_mid, to_right, to_left;
+
+    // acertou o chao: quica
+    floor_hit = (yi >= FLOOR_LEVEL - 1) & (vyi > 0);
+    yi = floor_hit ? FLOOR_LEVEL - 1 : yi;
+    vyi = floor_hit ? vyi * bounce : vyi;
+    bl[i] += floor_hit & (xi < SCREEN_WIDTH / 2);
+    br[i] += floor_hit & (xi >= SCREEN_WIDTH / 2);
+
+    // acertou a rede: reflete
+    net = (y_prev >= NET_TOP) | (yi >= NET_TOP);
+    net_mid = net & (xi >= NET_LEFT) & (xi <= NET_RIGHT);
+    net_left = net & !net_mid & (x_prev < SCREEN_WIDTH / 2) & (xi > SCREEN_WIDTH / 2);
+    net_right = net & !net_mid & !net_left & (x_prev > SCREEN_WIDTH / 2) & (xi < SCREEN_WIDTH / 2);
+    vxi = (net_mid | net_left | net_right) ? vxi * bounce : vxi;
+    xi = net_left ? NET_LEFT : (net_right ? NET_RIGHT : xi);
+
+    // passou por cima da rede: reseta bounces e registra de que lado a bola esta
+    over = !net;
+    to_mid = over & (r != MIDDLE) & (xi > SCREEN_WIDTH / 2 - 5) & (xi < SCREEN_WIDTH / 2 + 5);
+    to_right = over & !to_mid & (r == MIDDLE) & (xi > SCREEN_WIDTH / 2 + 5);
+    to_left = over & !to_mid & !to_right & (r == MIDDLE) & (xi < SCREEN_WIDTH / 2 - 5);
+    reg[i] = to_mid ? MIDDLE : (to_right ? RIGHT : (to_left ? LEFT : r));
+    br[i] = to_right ? 0 : br[i];
+    bl[i] = to_left ? 0 : bl[i];
+
+    x[i] = xi;
+    y[i] = yi;
+    vx[i] = vxi;
+    vy[i] = vyi;
+}
+
+#ifdef BOARD_BATCH_SIMD
+/**
+ * @brief Passo das bolas i a i + BATCH_LANES - 1
+ */
+static inline void board_batch_step_simd(board_batch_t *batch, uint32_t i, float dtf, float g_dt,
+                                         float half_g_dt2, float bounce) {
+    vfloat_t x_prev, y_prev, vx, vy, xi, yi, vxi, vyi;
+    vint_t r, bl, br, floor_hit, net, net_mid, net_left, net_right, over, to_mid, to_right, to_left;
+    vbyte_t bytes;
+
+    memcpy(&x_prev, batch->x + i, sizeof(x_prev));
+    memcpy(&y_prev, batch->y + i, sizeof(y_prev));
+    memcpy(&vx, batch->vx + i, sizeof(vx));
+    memcpy(&vy, batch->vy + i, sizeof(vy));
+    memcpy(&bytes, batch->region + i, sizeof(bytes));
+    r = __builtin_convertvector(bytes, vint_t);
+    memcpy(&bytes, batch->bounces_left + i, sizeof(bytes));
+    bl = __builtin_convertvector(bytes, vint_t);
+    memcpy(&bytes, batch->bounces_right + i, sizeof(bytes));
+    br = __builtin_convertvector(bytes, vint_t);
+
+    xi = x_prev + vx * dtf;
+    yi = y_prev + (vy * dtf + half_g_dt2);
+    vxi = vx;
+    vyi = vy + g_dt;
+
+    // acertou o chao: quica (mascara -1 soma 1 ao contador)
+    floor_hit = (yi >= FLOOR_LEVEL - 1) & (vyi > 0);
+    yi = VSELECT_F(floor_hit, (vfloat_t){} + (FLOOR_LEVEL - 1), yi);
+    vyi = VSELECT_F(floor_hit, vyi * bounce, vyi);
+    bl -= floor_hit & (xi < SCREEN_WIDTH / 2);
+    br -= floor_hit & (xi >= SCREEN_WIDTH / 2);
+
+    // acertou a rede: reflete
+    net = (y_prev >= NET_TOP) | (yi >= NET_TOP);
+    net_mid = net & (xi >= NET_LEFT) & (xi <= NET_RIGHT);
+    net_left = net & ~net_mid & (x_prev < SCREEN_WIDTH / 2) & (xi > SCREEN_WIDTH / 2);
+    net_right = net & ~net_mid & ~net_left & (x_prev > SCREEN_WIDTH / 2) & (xi < SCREEN_WIDTH / 2);
+    vxi = VSELECT_F(net_mid | net_left | net_right, vxi * bounce, vxi);
+    xi = VSELECT_F(net_left, (vfloat_t){} + (NET_LEFT), VSELECT_F(net_right, (vfloat_t){} + (NET_RIGHT), xi));
+
+    // passou por cima da rede: reseta bounces e registra de que lado a bola esta
+    over = ~net;
+    to_mid = over & (r != MIDDLE) & (xi > SCREEN_WIDTH / 2 - 5) & (xi < SCREEN_WIDTH / 2 + 5);
+    to_right = over & ~to_mid & (r == MIDDLE) & (xi > SCREEN_WIDTH / 2 + 5);
+    to_left = over & ~to_mid & ~to_right & (r == MIDDLE) & (xi < SCREEN_WIDTH / 2 - 5);
+    r = VSELECT_I(to_mid, (vint_t){} + MIDDLE,
+                  VSELECT_I(to_right, (vint_t){} + RIGHT, VSELECT_I(to_left, (vint_t){} + LEFT, r)));
+    br &= ~to_right;
+    bl &= ~to_left;
+
+    memcpy(batch->x + i, &xi, sizeof(xi));
+    memcpy(batch->y + i, &yi, sizeof(yi));
+    memcpy(batch->vx + i, &vxi, sizeof(vxi));
+    memcpy(batch->vy + i, &vyi, sizeof(vyi));
+    bytes = __builtin_convertvector(r, vbyte_t);
+    memcpy(batch->region + i, &bytes, sizeof(bytes));
+    bytes = __builtin_convertvector(bl & 0xff, vbyte_t);
+    memcpy(batch->bounces_left + i, &bytes, sizeof(bytes));
+    bytes = __builtin_convertvector(br & 0xff, vbyte_t);
+    memcpy(batch->bounces_right + i, &bytes, sizeof(bytes));
+}
+#endif
+
+void board_batch_update(board_batch_t *batch, uint32_t dt) {
+    const board_params_t *p = batch->params;
+    const float dtf = dt / 1000.0f, bounce = -p->restitution;
+    // mesmos termos, na mesma ordem, de board_update()
+    const float g_dt = p->g * dtf, half_g_dt2 = p->g * dtf * dtf / 2;
+    uint32_t i = 0;
+
+#ifdef BOARD_BATCH_SIMD
+    for (; i + BATCH_LANES <= batch->n; i += BATCH_LANES) {
+        board_batch_step_simd(batch, i, dtf, g_dt, half_g_dt2, bounce);
+    }
+#endif
+    for (; i < batch->n; i++) {
+        board_batch_step(batch, i, dtf, g_dt, half_g_dt2, bounce);
+    }
+}
+
+void board_batch_get(const board_batch_t *batch, uint32_t i, board_t *board) {
+    board->ball_pos.x = batch->x[i];
+    board->ball_pos.y = batch->y[i];
+    board->ball_vel.x = batch->vx[i];
+    board->ball_vel.y = batch->vy[i];
+    board->bounces_left = batch->bounces_left[i];
+    board->bounces_right = batch->bounces_right[i];
+    board->region = (region_t)batch->region[i];
+    board->params = batch->params;
+}
+
+void board_batch_set(board_batch_t *batch, uint32_t i, const board_t *board) {
+    batch->x[i] = board->ball_pos.x;
+    batch->y[i] = board->ball_pos.y;
+    batch->vx[i] = board->ball_vel.x;
+    batch->vy[i] = board->ball_vel.y;
+    batch->bounces_left[i] = board->bounces_left;
+    batch->bounces_right[i] = board->bounces_right;
+    batch->region[i] = (uint8_t)board->region;
+}
@@ -0,0 +1,267 @@
+/**
+ * @file clock.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Perfis de relogio (FEI, PEE e BLPI/VLPR) e troca em funcionamento
+ * @date 2026-10-19
+ */
+
+#include "clock.h"
+
+#include "I2C.h"
+#include "delay.h"
+#include "input.h"
+#include "mcu.h"
+#include "periph.h"
+#include "prof.h"
+#include "util.h"
+
+static const clock_profile_t clock_profiles[CLOCK_N_PROFILES] = {
+    [CLOCK_FEI_21MHZ] = {
+        .core = 20971520,  // 32768 * 640
+        .bus = 10485760,
+        .tpm = 20971520,
+        .outdiv1 = 0,
+        .outdiv4 = 1,
+        .i2c_icr = 0x22,  // 10485760 / 224 = 46,8 kHz
+        .vlpr = 0,
+    },
+    [CLOCK_PEE_48MHZ] = {
+        .core = 48000000,  // 8 MHz / 2 * 24 / 2
+        .bus = 24000000,
+        .tpm = 48000000,   // MCGPLLCLK / 2
+        .outdiv1 = 1,
+        .outdiv4 = 1,
+        .i2c_icr = 0x23,  // 24000000 / 256 = 93,75 kHz
+        .vlpr = 0,
+    },
+    [CLOCK_BLPI_4MHZ] = {
+        .core = 4000000,  // IRC rapido, FCRDIV = 0
+        .bus = 1000000,   // maximo em VLPR
+        .tpm = 0,         // FLL e PLL desligados: TPM sem relogio
+        .outdiv1 = 0,
+        .outdiv4 = 3,
+        .i2c_icr = 0x00,  // 1000000 / 20 = 50 kHz
+        .vlpr = 1,
+    },
+};
+
+static clock_id_t clock_current = CLOCK_FEI_21MHZ;  // estado de reset
+static clock_stats_t stats;
+
+// medicao da troca: ciclos do SysTick em trechos de frequencia conhecida
+static uint64_t mark_cycles;
+static uint32_t mark_hz;
+static uint64_t mark_ns;
+
+/**
+ * @brief Fecha o trecho atual da medicao (frequencia mudou ou troca terminou)
+ */
+static void clock_mark(void) {
+    uint64_t cycles;
+    if (mark_hz) {  // apenas dentro de clock_switch()
+        cycles = SysTick_getCycles();
+        mark_ns += (cycles - mark_cycles) * 1000000000 / mark_hz;
+        mark_cycles = cycles;
+        mark_hz = SIM_leCoreClock();
+    }
+}
+
+/**
+ * @brief Espera o campo CLKST indicar a fonte pedida para MCGOUTCLK
+ */
+static void clock_wait_clkst(uint8_t clkst) {
+    while (((MCG_S & MCG_S_CLKST_MASK) >> MCG_S_CLKST_SHIFT) != clkst) {
+    }
+    clock_mark();
+}
+
+/**
+ * @brief Ajusta os divisores do nucleo e do barramento
+ */
+static void clock_set_dividers(const clock_profile_t *p) {
+    SIM_CLKDIV1 = SIM_CLKDIV1_OUTDIV1(p->outdiv1) | SIM_CLKDIV1_OUTDIV4(p->outdiv4);
+    clock_mark();
+}
+
+/**
+ * @brief PEE -> PBE -> FBE (PLL desligado, nucleo no cristal)
+ */
+static void clock_leave_pee(void) {
+    MCG_C1 |= MCG_C1_CLKS(0b10);
+    clock_wait_clkst(0b10);
+    MCG_C6 &= ~MCG_C6_PLLS_MASK;
+    while (MCG_S & MCG_S_PLLST_MASK) {
+    }
+}
+
+/**
+ * @brief VLPR -> RUN e BLPI -> FBI
+ */
+static void clock_leave_blpi(void) {
+    SMC_PMCTRL &= ~SMC_PMCTRL_RUNM_MASK;
+    while (SMC_PMSTAT != 0x01) {  // RUN
+    }
+    MCG_C2 &= ~MCG_C2_LP_MASK;
+}
+
+/**
+ * @brief FEI/FBI -> FBE -> PBE -> PEE
+ */
+static void clock_enter_pee(const clock_profile_t *p) {
+    // cristal de 8 MHz em PTA18/PTA19 (alternativa 0 dos pinos, padrao do reset);
+    // IRCS mantido ate MCGOUTCLK deixar o IRC
+    MCG_C2 = (MCG_C2 & MCG_C2_IRCS_MASK) | MCG_C2_RANGE0(1) | MCG_C2_EREFS0_MASK;
+
+    // FBE: MCGOUTCLK = cristal; referencia do FLL = 8 MHz / 256 = 31,25 kHz
+    MCG_C1 = MCG_C1_CLKS(0b10) | MCG_C1_FRDIV(0b011);
+    while (!(MCG_S & MCG_S_OSCINIT0_MASK)) {
+    }
+    while (MCG_S & MCG_S_IREFST_MASK) {
+    }
+    clock_wait_clkst(0b10);
+
+    // PBE: PLL = 8 MHz / 2 * 24 = 96 MHz
+    MCG_C5 = MCG_C5_PRDIV0(1);
+    MCG_C6 = MCG_C6_PLLS_MASK | MCG_C6_VDIV0(0);
+    while (!(MCG_S & MCG_S_PLLST_MASK)) {
+    }
+    while (!(MCG_S & MCG_S_LOCK0_MASK)) {
+    }
+
+    // divisores antes de trocar a fonte: nucleo 48 MHz, barramento/flash 24 MHz
+    clock_set_dividers(p);
+    SIM_setaFLLPLL(1);  // TPM: MCGPLLCLK / 2
+
+    // PEE: MCGOUTCLK = PLL
+    MCG_C1 &= ~MCG_C1_CLKS_MASK;
+    clock_wait_clkst(0b11);
+}
+
+/**
+ * @brief FBE/FBI/FEI -> FEI
+ */
+static void clock_enter_fei(const clock_profile_t *p) {
+    // divisores antes de acelerar: FLL entra com os divisores do perfil
+    clock_set_dividers(p);
+    SIM_setaFLLPLL(0);  // TPM: MCGFLLCLK
+
+    // FEI: FLL com IRC lento, fator 640
+    MCG_C4 &= ~(MCG_C4_DMX32_MASK | MCG_C4_DRST_DRS_MASK);
+    MCG_C1 = MCG_C1_CLKS(0b00) | MCG_C1_IREFS_MASK;
+    while (!(MCG_S & MCG_S_IREFST_MASK)) {
+    }
+    clock_wait_clkst(0b00);
+    MCG_C2 &= ~(MCG_C2_EREFS0_MASK | MCG_C2_IRCS_MASK);
+}
+
+/**
+ * @brief FBE/FEI -> FBI -> BLPI -> VLPR
+ */
+static void clock_enter_blpi(const clock_profile_t *p) {
+    // IRC rapido de 4 MHz sem divisor
+    MCG_SC = (MCG_SC & ~MCG_SC_FCRDIV_MASK) | MCG_SC_FCRDIV(0);
+    MCG_C2 |= MCG_C2_IRCS_MASK;
+    while (!(MCG_S & MCG_S_IRCST_MASK)) {
+    }
+
+    // FBI: MCGOUTCLK = IRC
+    MCG_C1 = MCG_C1_CLKS(0b01) | MCG_C1_IREFS_MASK | MCG_C1_IRCLKEN_MASK;
+    while (!(MCG_S & MCG_S_IREFST_MASK)) {
+    }
+    clock_wait_clkst(0b01);
+    MCG_C2 &= ~MCG_C2_EREFS0_MASK;  // desliga o cristal
+
+    // divisores dentro dos limites de VLPR: nucleo 4 MHz, barramento/flash 1 MHz
+    clock_set_dividers(p);
+
+    // BLPI: desliga o FLL
+    MCG_C2 |= MCG_C2_LP_MASK;
+
+    // VLPR (SMC_PMPROT_AVLP habilitado por power_init())
+    SMC_PMCTRL = (SMC_PMCTRL & ~SMC_PMCTRL_RUNM_MASK) | SMC_PMCTRL_RUNM(0b10);
+    while (SMC_PMSTAT != 0x04) {  // VLPR
+    }
+}
+
+void clock_init(clock_id_t id) {
+    const clock_profile_t *p = &clock_profiles[id];
+
+    if (id == clock_current && id != CLOCK_FEI_21MHZ) {
+        return;
+    }
+    if (clock_current == CLOCK_BLPI_4MHZ) {
+        clock_leave_blpi();
+    } else if (clock_current == CLOCK_PEE_48MHZ) {
+        clock_leave_pee();
+    }
+    switch (id) {
+        case CLOCK_PEE_48MHZ:
+            clock_enter_pee(p);
+            break;
+        case CLOCK_BLPI_4MHZ:
+            clock_enter_blpi(p);
+            break;
+        case CLOCK_FEI_21MHZ:
+        default:
+            clock_enter_fei(p);
+            break;
+    }
+    clock_current = id;
+}
+
+void clock_switch(clock_id_t id) {
+    uint64_t t0;
+    uint32_t us;
+
+    if (id == clock_current) {
+        return;
+    }
+    // byte do LCD em processamento: o canal 1 conta no barramento que vai mudar
+    GPIO_LCD_fila_pausa();
+    // base de tempo parada no inicio da troca; a duracao eh somada no fim
+    t0 = get_time_us();
+    mark_cycles = SysTick_getCycles();
+    mark_hz = SIM_leCoreClock();
+    mark_ns = 0;
+
+    clock_init(id);
+    clock_mark();
+    mark_hz = 0;
+
+    us = (uint32_t)(mark_ns / 1000);
+    rebase_time_us(t0 + us);  // SysTick com o novo periodo
+    delay_init();
+    prof_init();
+    input_init();
+    GPIO_LCD_fila_init();
+    periph_i2c_set_baud(OLED_I2C, OLED_I2C_MULT, clock_get()->i2c_icr);
+
+    stats.switches++;
+    stats.last_us = us;
+    if (us > stats.max_us) {
+        stats.max_us = us;
+    }
+}
+
+const clock_profile_t *clock_get(void) {
+    return &clock_profiles[clock_current];
+}
+
+void clock_get_stats(clock_stats_t *out) {
+    *out = stats;
+}
+
+void clock_display_LCD(void) {
+    clock_stats_t s;
+    // "CLK trocas    12" e "ult   1830 M2410"
+    char line_n[17] = "CLK trocas      ";
+    char line_us[17] = "ult       M     ";
+
+    clock_get_stats(&s);
+    util_formata(s.switches < 100000 ? s.switches : 99999, line_n + 11, 5);
+    util_formata(s.last_us < 1000000 ? s.last_us : 999999, line_us + 3, 7);
+    util_formata(s.max_us < 100000 ? s.max_us : 99999, line_us + 11, 5);
+    GPIO_LCD_escreve_buffer(0x00, (uint8_t *)line_n);
+    GPIO_LCD_escreve_buffer(0x40, (uint8_t *)line_us);
+}
@@ -0,0 +1,102 @@
+/**
+ * @file delay.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Servico de atrasos calibrado pelo relogio do nucleo
+ * @date 2026-10-19
+ */
+
+#include "delay.h"
+
+#include "mcu.h"
+#include "util.h"
+
+// ciclos do nucleo por us em ponto fixo Q16
+static uint32_t delay_q16;
+static uint32_t delay_clock;  // Hz
+
+// duracoes do self-test: pulso E, comandos e limpeza do LCD, espera de inicializacao
+static const uint32_t delay_test_us[DELAY_TEST_N] = {1, 43, 1530, 30000};
+
+static inline uint64_t delay_cycles(uint32_t us) {
+    return ((uint64_t)us * delay_q16) >> 16;
+}
+
+void delay_init(void) {
+    delay_clock = SIM_leCoreClock();
+    delay_q16 = (uint32_t)(((uint64_t)delay_clock << 16) / 1000000);
+}
+
+void delay_us(uint32_t us) {
+    uint64_t end = SysTick_getCycles() + delay_cycles(us);
+    while (SysTick_getCycles() < end) {
+    }
+}
+
+void delay_start(delay_t *delay, uint32_t us) {
+    delay->end = get_time_us() + us;
+}
+
+uint8_t delay_expired(const delay_t *delay) {
+    return get_time_us() >= delay->end;
+}
+
+void delay_callback(swtimer_t *timer, uint32_t us, swtimer_fn_t fn, void *arg) {
+    swtimer_start(timer, (us + 999) / 1000, fn, arg);
+}
+
+void delay_selftest(delay_selftest_t *result) {
+    uint32_t bus = SIM_leBusClock(), start, cycles, lpo, i;
+
+    // o canal 1 eh da fila do LCD: so eh tomado depois do ultimo byte processado
+    while (!GPIO_LCD_fila_vazia()) {
+    }
+    PIT_ativaLivre(1);
+    for (i = 0; i < DELAY_TEST_N; i++) {
+        start = PIT_leContagem(1);
+        delay_us(delay_test_us[i]);
+        cycles = start - PIT_leContagem(1);  // contador decrescente
+        result->us[i] = delay_test_us[i];
+        result->err_ns[i] = (int32_t)((uint64_t)cycles * 1000000000 / bus) - (int32_t)(delay_test_us[i] * 1000);
+    }
+    PIT_desativa(1);
+
+    // LPTMR contando o LPO livremente (mesma configuracao de power_init())
+    SIM_SCGC5 |= SIM_SCGC5_LPTMR_MASK;
+    LPTMR0_CSR = LPTMR_CSR_TCF_MASK;
+    LPTMR0_PSR = LPTMR_PSR_PCS(0b01) | LPTMR_PSR_PBYP_MASK;
+    LPTMR0_CMR = LPTMR_CMR_COMPARE_MASK;
+    LPTMR0_CSR = LPTMR_CSR_TEN_MASK;
+    delay_us(DELAY_TEST_LPO_MS * 1000);
+    LPTMR0_CNR = 0;  // escrita captura o contador para leitura
+    lpo = LPTMR0_CNR;
+    LPTMR0_CSR = LPTMR_CSR_TCF_MASK;
+    result->lpo_err_permil = ((int32_t)lpo - DELAY_TEST_LPO_MS) * 1000 / DELAY_TEST_LPO_MS;
+}
+
+/**
+ * @brief Escreve v com sinal nas "digits" posicoes de str (sinal na primeira)
+ */
+static void delay_format_signed(int32_t v, char *str, uint8_t digits) {
+    str[0] = v < 0 ? '-' : '+';
+    util_formata(v < 0 ? -v : v, str + 1, digits - 1);
+}
+
+void delay_selftest_run(void) {
+    delay_selftest_t result;
+    int32_t worst = 0;
+    uint8_t i;
+    char line_err[17] = "erro ns:        ";
+    char line_lpo[17] = "LPO 0/00:       ";
+
+    delay_selftest(&result);
+    for (i = 0; i < DELAY_TEST_N; i++) {
+        if ((result.err_ns[i] < 0 ? -result.err_ns[i] : result.err_ns[i]) > (worst < 0 ? -worst : worst)) {
+            worst = result.err_ns[i];
+        }
+    }
+    delay_format_signed(worst, line_err + 9, 7);
+    GPIO_LCD_escreve_string(0x00, (uint8_t *)line_err);
+    delay_format_signed(result.lpo_err_permil, line_lpo + 10, 6);
+    GPIO_LCD_escreve_string(0x40, (uint8_t *)line_lpo);
+}
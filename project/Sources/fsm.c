@@ -0,0 +1,95 @@
+/**
+ * @file fsm.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Maquina de estados por tabela
+ * @date 2026-10-19
+ */
+
+#include "fsm.h"
+
+#include <stddef.h>
+
+#include "mcu.h"
+#include "util.h"
+
+void fsm_init(fsm_t *fsm, const fsm_state_t *states, const fsm_transition_t *table, uint8_t n_states,
+              uint8_t n_events, uint8_t initial) {
+    fsm->states = states;
+    fsm->table = table;
+    fsm->n_states = n_states;
+    fsm->n_events = n_events;
+    fsm->pending = 0;
+    fsm->stats = (fsm_stats_t){0};
+    if (states[initial].entry != NULL) {
+        states[initial].entry();
+    }
+    fsm->stats.entries[initial]++;
+    fsm->t_entry = get_time_us();
+    fsm->state = initial;
+}
+
+void fsm_post(fsm_t *fsm, uint8_t event) {
+    uint32_t primask = util_irq_desativa();
+    fsm->pending |= 1u << event;
+    util_irq_restaura(primask);
+}
+
+/**
+ * @brief Retira o evento pendente de menor numero
+ *
+ * @return evento ou FSM_STAY se nao houver
+ */
+static uint8_t fsm_take(fsm_t *fsm) {
+    uint32_t primask;
+    uint8_t event;
+
+    primask = util_irq_desativa();
+    for (event = 0; event < fsm->n_events && !(fsm->pending & (1u << event)); event++) {
+    }
+    if (event < fsm->n_events) {
+        fsm->pending &= ~(1u << event);
+    } else {
+        event = FSM_STAY;
+    }
+    util_irq_restaura(primask);
+    return event;
+}
+
+void fsm_run(fsm_t *fsm) {
+    const fsm_transition_t *t;
+    uint64_t now;
+    uint8_t event, from;
+
+    while ((event = fsm_take(fsm)) != FSM_STAY) {
+        from = fsm->state;
+        t = &fsm->table[from * fsm->n_events + event];
+        if (!t->used) {
+            fsm->stats.ignored++;
+            continue;
+        }
+        fsm->stats.transitions[from][event]++;
+        if (t->next == FSM_STAY) {
+            if (t->action != NULL) {
+                t->action();
+            }
+            continue;
+        }
+
+        if (fsm->states[from].exit != NULL) {
+            fsm->states[from].exit();
+        }
+        if (t->action != NULL) {
+            t->action();
+        }
+        if (fsm->states[t->next].entry != NULL) {
+            fsm->states[t->next].entry();
+        }
+        // estado visivel so muda com a transicao completa
+        now = get_time_us();
+        fsm->stats.time_us[from] += now - fsm->t_entry;
+        fsm->stats.entries[t->next]++;
+        fsm->t_entry = now;
+        fsm->state = t->next;
+    }
+}
@@ -9,293 +9,643 @@
 #include "game.h"
 
 #include <math.h>
+#include <stddef.h>
 
 #include "ISR.h"
+#include "ai.h"
+#include "fsm.h"
+#include "input.h"
+#include "latency.h"
 #include "mcu.h"
+#include "periph.h"
+#include "power.h"
+#include "prof.h"
+#include "sched.h"
+#include "swtimer.h"
+#include "util.h"
 
 // valor absoluto da diferenca de dois valores
 #define ABS_DIFF(a, b) ((a) > (b) ? ((a) - (b)) : ((b) - (a)))
 
-// constantes fisicas
-#define PIXELS_P_METER 4.712                   // 112 pixels / 23.77 m
-#define G 9.81 * PIXELS_P_METER / 1000 / 1000  // pixels / ms^2
-#define V0 5 * PIXELS_P_METER / 1000           // pixels / ms
-
-// dimensoes da quadra
-#define NET_TOP SCREEN_HEIGHT - 24
-#define NET_LEFT SCREEN_WIDTH / 2 - 1
-#define NET_RIGHT SCREEN_WIDTH / 2 + 1
-#define FLOOR_LEVEL SCREEN_HEIGHT - 6
-#define FLOOR_HEIGHT 2
-
 // dimensoes do retangulo onde info sao mostradas nas telas de inicio e ganhador
 #define WAIT_SCREEN_INNER_RECT_XMIN 24
 #define WAIT_SCREEN_INNER_RECT_XMAX 104
 #define WAIT_SCREEN_INNER_RECT_YMIN 16
 #define WAIT_SCREEN_INNER_RECT_YMAX 48
 
-void game_loop(uint8_t sets_to_win) {
-    player_t winner_match = PLAYER_NONE, winner_point = PLAYER_NONE;
-    board_t *board = ISR_getBoard();
-    uint32_t t1, t2;  // ms
-    ISR_setState(PREPARA_INICIO);
-
-    while (1) {
-        switch (ISR_getState()) {
-            case PREPARA_INICIO:
-                board_reset(board);
-                GPIO_switches_IRQAn_interrupt_ativa(12, BTN_IRQC);
-                ISR_setState(INICIO);
-                board_init_LCD(board);
-                game_start_screen_display();
-                break;
-            case INICIO:
-                game_display_checkerboard();
-                break;
-            case LAUNCH_BALL:
-                board_reset_ball(board);
-                ISR_setState(PLAYER_TURN);
-                reset_time();
-                t1 = get_time();
-                if (board->ball_vel.x < 0) {
-                    // bola foi para a esquerda: jogador 1 deve rebater
-                    GPIO_switches_IRQAn_interrupt_ativa(4, BTN_IRQC);
-                    ISR_setPlayer(PLAYER_1);
-                } else {
-                    // bola foi para a direita: jogador 2 deve rebater
-                    GPIO_switches_IRQAn_interrupt_ativa(5, BTN_IRQC);
-                    ISR_setPlayer(PLAYER_2);
-                }
-                break;
-            case PLAYER_TURN:
-                t2 = get_time();
-                if (t1 > t2) {
-                    reset_time();
-                    t1 = get_time();
-                    break;
-                }
-                board_update(board, t2 - t1);
-                board_display(board);
-                winner_point = board_check_winner_point(board);
-                ISR_setState(LCD_UPDATE);
-                t1 = t2;
-                break;
-            case LCD_UPDATE:
-                if (winner_point == PLAYER_NONE) {
-                    // ponto ainda nao acabou: nada a fazer
-                    ISR_setState(PLAYER_TURN);
-                    break;
-                }
-                // jogador venceu ponto: desabilitar botoes
-                GPIO_switches_IRQAn_interrupt_desativa(4);
-                GPIO_switches_IRQAn_interrupt_desativa(5);
-
-                board_update_score(board, winner_point, 1);
-                winner_match = board_check_winner_match(board, sets_to_win);
-                ISR_setState(winner_match != PLAYER_NONE ? WIN_SCREEN : LAUNCH_BALL);
-                break;
-            case WIN_SCREEN:
-                game_winner_screen_display(winner_match);
-                ISR_setState(WIN_VISU);
-                reset_time();
-                t1 = get_time();
-            case WIN_VISU:
-                // 5s para visualizacao
-                while (get_time() - t1 < 5000) {
-                    game_display_checkerboard();
-                }
-                ISR_setState(PREPARA_INICIO);
-                break;
-            default:
-                break;
-        }
+// periodos das tarefas (us)
+#define GAME_RENDER_PERIOD_US 100000    // um quadro do OLED leva ~92 ms (I2C a 100 kHz)
+#define GAME_LCD_PERIOD_US 50000
+
+// temporizadores de software (ms)
+#define GAME_BLINK_MS 500               // tabuleiro das telas de espera
+#define GAME_WIN_SCREEN_MS 5000         // tela de vencedor
+#define GAME_HIT_SOUND_MS 170           // ~50 periodos da nota de rebatida
+#define GAME_PROF_HOLD_MS 1000          // PTA4 pressionado na tela de inicio: proxima pagina dos histogramas
+
+// historico da fisica para aplicar rebatidas no instante da borda
+#define GAME_REWIND_TICKS 8             // 16 ms a PHYSICS_TICK_HZ
+
+// prioridades das tarefas (0 = mais alta)
+#define GAME_PRIO_CONTROL 0
+#define GAME_PRIO_AUDIO 1
+#define GAME_PRIO_LCD 2
+#define GAME_PRIO_RENDER 3
+
+// perfis de relogio por estado (clock.h)
+#define GAME_CLOCK_IDLE CLOCK_BLPI_4MHZ  // telas de espera
+#define GAME_CLOCK_PLAY CLOCK_PROFILE    // durante a partida
+
+// eventos da maquina de estados (fsm.h); ordem = prioridade quando pendentes juntos
+typedef enum {
+    EV_START,        // PTA12 na tela de inicio
+    EV_POINT,        // alguem venceu o ponto (game_physics_tick())
+    EV_SERVE,        // ponto contabilizado, partida continua
+    EV_MATCH_OVER,   // ponto contabilizado, partida encerrada
+    EV_WIN_TIMEOUT,  // fim da tela de vencedor
+    EV_PROF_PRESS,   // PTA4 na tela de inicio
+    EV_PROF_HOLD,    // PTA4 ainda pressionado apos GAME_PROF_HOLD_MS
+    GAME_N_EVENTS
+} game_event_t;
+
+// pedidos de escrita no LCD
+#define LCD_INIT 0x1
+#define LCD_GAMES 0x2
+#define LCD_POINTS 0x4
+#define LCD_PROF 0x8
+#define LCD_MARKER 0x10
+
+// paginas de LCD_PROF: uma por fase (prof.h), as trocas de relogio (clock.h) e a fila do LCD (GPIO_lcd.h)
+#define GAME_PROF_PAGES (PROF_N_PHASES + 2)
+
+/**
+ * @brief Estado compartilhado pelas tarefas do jogo
+ */
+static struct {
+    board_t *board;
+    uint8_t sets_to_win;
+    player_t ai_player;  // PLAYER_NONE: dois jogadores
+    prng_t rng;
+    ai_t ai;
+    player_t winner_point;
+    player_t winner_match;
+    uint8_t lcd_pending;      // LCD_INIT | LCD_GAMES | LCD_POINTS | LCD_PROF | LCD_MARKER
+    uint8_t prof_page;        // proxima pagina mostrada por LCD_PROF
+    uint8_t prof_shown;       // 1: LCD mostra histogramas em vez do placar
+    board_t lcd_games;        // placar no momento em que o game foi fechado
+    player_t lcd_set_winner;  // vencedor do set fechado junto com lcd_games, ou PLAYER_NONE
+    player_t lcd_marker;      // jogador marcado ao lado do nome por LCD_MARKER
+    uint8_t lcd_marker_glyph; // LCD_GLIFO_SAQUE durante a partida, LCD_GLIFO_BOLA no vencedor
+    uint8_t screen_pending;   // 1: desenhar tela de inicio ou de vencedor
+    volatile uint8_t sound_request;  // escrito por PIT_IRQHandler (game_hit_sound(): game_play_input/game_ai_hit)
+    volatile uint8_t blink_pending;  // escrito por game_blink_timeout
+    int8_t task_control;
+    int8_t task_audio;
+    int8_t task_lcd;
+    int8_t task_render;
+    swtimer_t timer_win;
+    swtimer_t timer_blink;
+    swtimer_t timer_sound;
+    swtimer_t timer_prof;
+    fsm_t fsm;
+} game;
+
+/**
+ * @brief Estados da partida apos os ultimos passos da fisica (contexto de PIT_IRQHandler)
+ *
+ * Uma rebatida nunca eh aplicada antes de outra: o historico eh esvaziado a cada
+ * rebatida e a cada lancamento
+ */
+static struct {
+    board_t state[GAME_REWIND_TICKS];  // estado apos o passo
+    uint32_t t[GAME_REWIND_TICKS];     // inicio do passo (SysTick_getCycles32())
+    uint8_t head;                      // proxima posicao
+    uint8_t n;                         // passos validos
+    uint32_t advance_us;               // parte do proximo passo ja simulada por game_hit_at()
+    uint32_t t_launch;                 // lancamento da bola (SysTick_getCycles32())
+} rewind;
+
+/**
+ * @brief Posta um evento e libera a tarefa de controle, que executa as transicoes; pode ser chamada de ISRs
+ */
+static void game_post(game_event_t event) {
+    fsm_post(&game.fsm, event);
+    sched_post(game.task_control);
+}
+
+/**
+ * @brief Fim da tela de vencedor (contexto de SysTick_Handler)
+ */
+static void game_win_timeout(void *arg) {
+    (void)arg;
+    game_post(EV_WIN_TIMEOUT);
+}
+
+/**
+ * @brief Hora de alternar o tabuleiro: libera a tarefa de desenho (contexto de SysTick_Handler)
+ */
+static void game_blink_timeout(void *arg) {
+    (void)arg;
+    game.blink_pending = 1;
+    sched_post(game.task_render);
+}
+
+/**
+ * @brief Fim do som de rebatida (contexto de SysTick_Handler)
+ */
+static void game_sound_timeout(void *arg) {
+    (void)arg;
+    periph_tpm_set_mod(SOUND_TPM, 0);
+    periph_tpm_set_cnv(SOUND_TPM, SOUND_TPM_CH, 0);
+}
+
+/**
+ * @brief PTA4 continua pressionado apos GAME_PROF_HOLD_MS: mostra a proxima pagina (contexto de SysTick_Handler)
+ */
+static void game_prof_timeout(void *arg) {
+    (void)arg;
+    if (!(GPIOA_PDIR & GPIO_PIN(4))) {
+        game_post(EV_PROF_HOLD);
     }
 }
 
-void game_display_checkerboard(void) {
-    static uint8_t toggle = 0;
-    uint8_t i, j;
-    for (i = 0; i < SCREEN_WIDTH; i++) {
-        for (j = 0; j < SCREEN_HEIGHT; j++) {
-            // nao fazer nada na regiao de informacoes
-            if (i >= WAIT_SCREEN_INNER_RECT_XMIN && i < WAIT_SCREEN_INNER_RECT_XMAX && j >= WAIT_SCREEN_INNER_RECT_YMIN && j < WAIT_SCREEN_INNER_RECT_YMAX) {
-                continue;
-            }
-            // quadrados de 8x8
-            if ((i / 8 + j / 8) % 2 == toggle) {
-                I2C_OLED_setPixel(i, j);
-            } else {
-                I2C_OLED_clrPixel(i, j);
-            }
-        }
+/**
+ * @brief Programa a nota de rebatida no TPM1 com o relogio atual do TPM
+ */
+static void game_sound_note(void) {
+    uint16_t valor = (uint16_t)((0.003405 * clock_get()->tpm) / 128);
+    periph_tpm_set_mod(SOUND_TPM, valor);
+    periph_tpm_set_cnv(SOUND_TPM, SOUND_TPM_CH, (uint16_t)(valor * 0.5));  // amplitude: 1/2 potencia
+}
+
+/**
+ * @brief Entra ou sai das telas de espera (inicio e vencedor)
+ *
+ * Nas telas de espera nada eh periodico: as tarefas so rodam quando liberadas por
+ * eventos (botao PTA12, temporizadores da tela e do tabuleiro), o PIT da fisica
+ * fica desligado, o nucleo passa ao perfil de relogio economico e o modo ocioso
+ * pode usar VLPS
+ *
+ * @param[in] waiting 1 ao entrar numa tela de espera, 0 ao lancar a bola
+ */
+static void game_set_waiting(uint8_t waiting) {
+    if (waiting) {
+        PIT_desativa(0);
+    }
+    clock_switch(waiting ? GAME_CLOCK_IDLE : GAME_CLOCK_PLAY);
+    if (swtimer_active(&game.timer_sound)) {
+        // nota em andamento: MOD depende do relogio do TPM
+        game_sound_note();
     }
-    // inverte quadrados
-    toggle = (toggle + 1) % 2;
 
-    I2C_OLED_redisplay();
-    espera_2us(250000);
-}
-
-void board_reset(board_t *board) {
-    board->ball_pos.x = 0;
-    board->ball_pos.y = 0;
-    board->ball_vel.x = 0;
-    board->ball_vel.y = 0;
-    board->score[0].sets = 0;
-    board->score[1].sets = 0;
-    board->score[0].games = 0;
-    board->score[1].games = 0;
-    board->score[0].points = 0;
-    board->score[1].points = 0;
-    board->bounces_left = 0;
-    board->bounces_right = 0;
-}
-
-void board_update(board_t *board, uint32_t dt) {
-    static region_t region_prev = MIDDLE;
-    float x_prev = board->ball_pos.x, y_prev = board->ball_pos.y;
-
-    // x_{k} = x_{k-1} + vx * dt
-    board->ball_pos.x += board->ball_vel.x * dt;
-    // S2 = S1 + V*t + a*t^2/2
-    board->ball_pos.y += board->ball_vel.y * dt + G * dt * dt / 2;
-    // vy_{k} = vy_{k-1} + g * dt
-    board->ball_vel.y += G * dt;
-
-    if (board->ball_pos.y >= FLOOR_LEVEL - 1 && board->ball_vel.y > 0) {
-        // acertou o chao: quica
-        board->ball_pos.y = FLOOR_LEVEL - 1;
-        board->ball_vel.y *= -.8;
-        if (board->ball_pos.x < SCREEN_WIDTH / 2) {
-            board->bounces_left++;
-        } else {
-            board->bounces_right++;
-        }
+    if (waiting) {
+        sched_stop(game.task_lcd);
+        sched_stop(game.task_render);
+        // escreve o que ja foi pedido e desenha a tela de espera
+        sched_post(game.task_lcd);
+        sched_post(game.task_render);
+    } else {
+        sched_start(game.task_lcd, 0);
+        sched_start(game.task_render, 0);
+        PIT_ativa(0, clock_get()->bus / PHYSICS_TICK_HZ);
     }
+    power_set_deep(waiting);
+}
+
+/**
+ * @brief Rebatida do jogador controlado pelo microcontrolador (mesmo efeito da rebatida por botao)
+ *
+ * @param[in,out] board estrutura do estado da partida
+ */
+static void game_ai_hit(board_t *board) {
+    game_hit_sound();
+    board_hit_ball(board);
+    rewind.n = 0;
+    ISR_swapPlayer();
+}
 
-    if (y_prev >= NET_TOP || board->ball_pos.y >= NET_TOP) {
-        // acertou a rede: reflete
-        if (board->ball_pos.x >= NET_LEFT && board->ball_pos.x <= NET_RIGHT) {
-            board->ball_vel.x *= -.8;
-        } else if (x_prev < SCREEN_WIDTH / 2 && board->ball_pos.x > SCREEN_WIDTH / 2) {
-            // acertou da esquerda
-            board->ball_vel.x *= -.8;
-            board->ball_pos.x = NET_LEFT;
-        } else if (x_prev > SCREEN_WIDTH / 2 && board->ball_pos.x < SCREEN_WIDTH / 2) {
-            // acertou da direita
-            board->ball_vel.x *= -.8;
-            board->ball_pos.x = NET_RIGHT;
+/**
+ * @brief Aplica uma rebatida no instante da borda do botao
+ *
+ * Usa o historico dos ultimos passos da fisica: volta ao estado valido no instante
+ * da borda, rebate e simula de novo ate o passo atual, de modo que a rebatida nao
+ * depende de quando o evento foi tratado. Bordas mais antigas que o historico,
+ * mas posteriores ao lancamento, sao aplicadas no estado atual
+ *
+ * @param[in,out] board estrutura do estado da partida
+ * @param[in] t_edge instante da borda (SysTick_getCycles32())
+ */
+static void game_hit_at(board_t *board, uint32_t t_edge) {
+    uint32_t offset_us;
+    uint8_t i = 0, k, steps;
+
+    // estado mais recente valido antes da borda (rewind.state[i] vale a partir de rewind.t[i])
+    for (k = 0; k < rewind.n; k++) {
+        i = (rewind.head + GAME_REWIND_TICKS - 1 - k) % GAME_REWIND_TICKS;
+        if ((int32_t)(t_edge - rewind.t[i]) >= 0) {
+            break;
         }
+    }
+    if (k == rewind.n) {
+        // borda mais antiga que o historico (ou historico vazio): aplica no estado atual
+        board_hit_ball(board);
+        rewind.n = 0;
+        return;
+    }
+
+    offset_us = (uint32_t)((uint64_t)(t_edge - rewind.t[i]) * 1000000 / clock_get()->core);
+    if (offset_us > PHYSICS_TICK_US) {
+        offset_us = PHYSICS_TICK_US;
+    }
+    if (k == 0) {
+        // borda depois do ultimo passo: simula ate ela e o proximo passo faz o resto
+        board_update(board, offset_us);
+        board_hit_ball(board);
+        rewind.advance_us = offset_us;
     } else {
-        // passou por cima da rede: reseta bounces e gerencia quem pode rebater a bola
-        if (region_prev != MIDDLE && board->ball_pos.x > SCREEN_WIDTH / 2 - 5 && board->ball_pos.x < SCREEN_WIDTH / 2 + 5) {
-            // bola no meio
-            region_prev = MIDDLE;
-            GPIO_switches_IRQAn_interrupt_desativa(4);
-            GPIO_switches_IRQAn_interrupt_desativa(5);
-        } else if (region_prev == MIDDLE && board->ball_pos.x > SCREEN_WIDTH / 2 + 5) {
-            // passou da esquerda para a direita
-            region_prev = RIGHT;
-            board->bounces_right = 0;
-            GPIO_switches_IRQAn_interrupt_ativa(5, BTN_IRQC);
-        } else if (region_prev == MIDDLE && board->ball_pos.x < SCREEN_WIDTH / 2 - 5) {
-            // passou da direita para a esquerda
-            region_prev = LEFT;
-            board->bounces_left = 0;
-            GPIO_switches_IRQAn_interrupt_ativa(4, BTN_IRQC);
+        // borda k passos atras: volta ao estado daquele passo e simula de novo ate o atual
+        *board = rewind.state[i];
+        board_update(board, offset_us);
+        board_hit_ball(board);
+        board_update(board, PHYSICS_TICK_US - offset_us);
+        for (steps = 1; steps < k; steps++) {
+            board_update(board, PHYSICS_TICK_US);
         }
     }
+    rewind.n = 0;
 }
 
-player_t board_check_winner_point(board_t *board) {
-    // IMPROV: take into consideration court dimensions
-    uint8_t ball_is_out = board->ball_pos.x < 0 || board->ball_pos.x >= SCREEN_WIDTH;
-    if (board->bounces_left > 1 || (board->bounces_left == 1 && (ball_is_out))) {
-        return PLAYER_2;
-    }
-    if (board->bounces_right > 1 || (board->bounces_right == 1 && (ball_is_out))) {
-        return PLAYER_1;
-    }
-    if (board->ball_pos.x < 0) {  // out from player 2
-        return PLAYER_1;
+void game_play_input(board_t *board, const input_event_t *ev) {
+    player_t player = ISR_getPlayer();
+    uint8_t pin = player == PLAYER_1 ? 4 : 5;
+    region_t side = player == PLAYER_1 ? LEFT : RIGHT;
+
+    // so o jogador da vez, humano, com a bola do seu lado da rede
+    if (ev->pin != pin || player == game.ai_player || board->region != side) {
+        return;
     }
-    if (board->ball_pos.x >= SCREEN_WIDTH) {  // out from player 1
-        return PLAYER_2;
+    // borda anterior ao lancamento (enfileirada na tela de espera): descarta
+    if ((int32_t)(ev->t - rewind.t_launch) < 0) {
+        return;
     }
-    return PLAYER_NONE;
+    game_hit_sound();
+    game_hit_at(board, ev->t);
+    latency_hit(ev->t);
+    ISR_swapPlayer();
 }
 
-player_t board_check_winner_match(board_t *board, uint8_t sets_to_win) {
-    if (board->score[0].sets >= sets_to_win) {
-        return PLAYER_1;
+void game_physics_tick(board_t *board) {
+    uint32_t t0;
+    uint8_t hit;
+
+    t0 = prof_begin();
+    board_update(board, PHYSICS_TICK_US - rewind.advance_us);
+    rewind.advance_us = 0;
+    rewind.state[rewind.head] = *board;
+    rewind.t[rewind.head] = t0;
+    rewind.head = (rewind.head + 1) % GAME_REWIND_TICKS;
+    if (rewind.n < GAME_REWIND_TICKS) {
+        rewind.n++;
     }
-    if (board->score[1].sets >= sets_to_win) {
-        return PLAYER_2;
+    prof_end(PROF_PHYSICS, t0);
+    if (game.ai_player != PLAYER_NONE) {
+        t0 = prof_begin();
+        hit = ai_update(&game.ai, board, PHYSICS_TICK_US);
+        prof_end(PROF_AI, t0);
+        if (hit && ISR_getPlayer() == game.ai_player) {
+            game_ai_hit(board);
+        }
+    }
+    t0 = prof_begin();
+    game.winner_point = board_check_winner_point(board);
+    prof_end(PROF_WINNER, t0);
+    if (game.winner_point != PLAYER_NONE) {
+        // para a bola ate o proximo lancamento
+        PIT_desativa(0);
+        game_post(EV_POINT);
     }
-    return PLAYER_NONE;
 }
 
-void board_reset_ball(board_t *board) {
-    board->ball_pos.x = SCREEN_WIDTH / 2;
-    board->ball_pos.y = 8;
-    board->ball_vel.x = get_time() & 0x1 ? V0 : -V0;
-    board->ball_vel.y = 0;
-    board->bounces_left = 0;
-    board->bounces_right = 0;
+/**
+ * @brief Tela de inicio: placar zerado, tela de espera (entrada em INICIO)
+ */
+static void game_enter_start(void) {
+    board_reset(game.board);
+    game.lcd_pending |= LCD_INIT;
+    game.screen_pending = 1;
+    game_set_waiting(1);
 }
 
-void board_hit_ball(board_t *board) {
-    // velocidade horizontal sempre aumenta
-    board->ball_vel.x *= -1.1;
-    if (board->ball_vel.y > 0) {
-        // bola caindo: reflete velocidade vertical
-        board->ball_vel.y *= -1;
-    } else {
-        // bola subindo: bola fica mais rapida
-        board->ball_vel.y *= 1.1;
+/**
+ * @brief Saida de INICIO: se o LCD mostrava os histogramas, volta ao placar
+ */
+static void game_exit_start(void) {
+    swtimer_cancel(&game.timer_prof);
+    if (game.prof_shown) {
+        game.prof_shown = 0;
+        game.lcd_pending |= LCD_INIT;
     }
 }
 
-void board_update_score(board_t *board, player_t winner, uint8_t games_to_set) {
-    if (winner != PLAYER_1 && winner != PLAYER_2) {
-        // ERROR
-        return;
-    }
-    uint8_t p_idx = ((uint8_t)winner) - 1;
-    switch (board->score[p_idx].points) {
-        case 0:
-            board->score[p_idx].points = 15;
-            break;
-        case 15:
-            board->score[p_idx].points = 30;
+/**
+ * @brief PTA4 pressionado na tela de inicio
+ *
+ * Se o botao continuar pressionado por GAME_PROF_HOLD_MS, o LCD passa a mostrar
+ * a proxima pagina dos histogramas de tempo por fase (prof.h) ou, depois da
+ * ultima fase, das trocas de relogio (clock.h) e da fila do LCD (GPIO_lcd.h).
+ * O placar volta ao lancar a bola
+ */
+static void game_prof_press(void) {
+    swtimer_start(&game.timer_prof, GAME_PROF_HOLD_MS, game_prof_timeout, NULL);
+}
+
+/**
+ * @brief Pede ao LCD a proxima pagina dos histogramas (ou das trocas de relogio ou da fila do LCD)
+ */
+static void game_prof_page(void) {
+    game.lcd_pending |= LCD_PROF;
+    sched_post(game.task_lcd);
+}
+
+/**
+ * @brief Lanca a bola (entrada em PLAYER_TURN)
+ *
+ * O PIT da fisica eh ligado aqui, mas game_physics_tick() so passa a ser chamada
+ * quando fsm_run() conclui a transicao
+ */
+static void game_enter_play(void) {
+    game_set_waiting(0);
+    board_reset_ball(game.board, &game.rng);
+    rewind.n = 0;
+    rewind.advance_us = 0;
+    rewind.t_launch = SysTick_getCycles32();
+    ai_reset(&game.ai);
+    // bola foi para a esquerda: jogador 1 deve rebater; para a direita: jogador 2
+    ISR_setPlayer(game.board->ball_vel.x < 0 ? PLAYER_1 : PLAYER_2);
+    game.lcd_marker = ISR_getPlayer();
+    game.lcd_marker_glyph = LCD_GLIFO_SAQUE;
+    game.lcd_pending |= LCD_MARKER;
+}
+
+/**
+ * @brief Contabiliza o ponto e decide se a partida continua (entrada em LCD_UPDATE)
+ */
+static void game_enter_point(void) {
+    board_update_score(game.board, game.winner_point, 1);
+    game.winner_match = board_check_winner_match(game.board, game.sets_to_win);
+    fsm_post(&game.fsm, game.winner_match != PLAYER_NONE ? EV_MATCH_OVER : EV_SERVE);
+}
+
+/**
+ * @brief Tela de vencedor por GAME_WIN_SCREEN_MS (entrada em WIN_VISU)
+ */
+static void game_enter_win(void) {
+    game.screen_pending = 1;
+    game.lcd_marker = game.winner_match;
+    game.lcd_marker_glyph = LCD_GLIFO_BOLA;
+    game.lcd_pending |= LCD_MARKER;
+    swtimer_start(&game.timer_win, GAME_WIN_SCREEN_MS, game_win_timeout, NULL);
+    game_set_waiting(1);
+}
+
+// acoes de entrada e saida, indexadas por state_t
+static const fsm_state_t game_states[GAME_N_STATES] = {
+    [INICIO] = {game_enter_start, game_exit_start},
+    [PLAYER_TURN] = {game_enter_play, NULL},
+    [LCD_UPDATE] = {game_enter_point, NULL},
+    [WIN_VISU] = {game_enter_win, NULL},
+};
+
+// transicoes: estado x evento; celulas vazias ignoram o evento
+static const fsm_transition_t game_table[GAME_N_STATES][GAME_N_EVENTS] = {
+    [INICIO] = {
+        [EV_START] = FSM_GOTO(PLAYER_TURN, NULL),
+        [EV_PROF_PRESS] = FSM_INTERNAL(game_prof_press),
+        [EV_PROF_HOLD] = FSM_INTERNAL(game_prof_page),
+    },
+    [PLAYER_TURN] = {
+        [EV_POINT] = FSM_GOTO(LCD_UPDATE, NULL),
+    },
+    [LCD_UPDATE] = {
+        [EV_SERVE] = FSM_GOTO(PLAYER_TURN, NULL),
+        [EV_MATCH_OVER] = FSM_GOTO(WIN_VISU, NULL),
+    },
+    [WIN_VISU] = {
+        [EV_WIN_TIMEOUT] = FSM_GOTO(INICIO, NULL),
+    },
+};
+
+/**
+ * @brief Converte os eventos dos botoes nas telas de espera em eventos da maquina de estados
+ *
+ * Com o PIT desligado, a tarefa de controle eh a consumidora da fila (input.h).
+ * Para no primeiro PTA12, deixando o resto da fila para o passo da fisica
+ */
+static void game_wait_input(void) {
+    input_event_t ev;
+
+    while ((game_state() == INICIO || game_state() == WIN_VISU) && input_pop(&ev)) {
+        if (ev.pin == 12) {
+            fsm_post(&game.fsm, EV_START);
             break;
-        case 30:
-            board->score[p_idx].points = 40;
+        }
+        if (ev.pin == 4) {
+            fsm_post(&game.fsm, EV_PROF_PRESS);
+        }
+    }
+}
+
+/**
+ * @brief Tarefa de controle do fluxo do jogo
+ *
+ * Liberada apenas por eventos (game_post()): executa as transicoes pendentes da
+ * maquina de estados. Durante o ponto a fisica roda em game_physics_tick()
+ */
+static void game_control_task(void *arg) {
+    (void)arg;
+    game_wait_input();
+    fsm_run(&game.fsm);
+}
+
+/**
+ * @brief Tarefa de desenho no OLED
+ *
+ * Nas telas de espera mostra a tela pedida e alterna o tabuleiro a cada
+ * GAME_BLINK_MS (game.timer_blink); durante o ponto desenha uma copia do estado
+ * mais recente da partida, tirada entre dois passos da fisica, e marca a latencia
+ * da rebatida que a copia contem (latency.h)
+ */
+static void game_render_task(void *arg) {
+    board_t snapshot;
+    uint32_t primask, t_edge;
+    uint8_t hit;
+    (void)arg;
+
+    switch (game_state()) {
+        case INICIO:
+        case WIN_VISU:
+            if (game.screen_pending) {
+                game.screen_pending = 0;
+                if (game_state() == INICIO) {
+                    game_start_screen_display();
+                } else {
+                    game_winner_screen_display(game.winner_match);
+                }
+                game.blink_pending = 0;
+                game_display_checkerboard();
+                swtimer_start(&game.timer_blink, GAME_BLINK_MS, game_blink_timeout, NULL);
+            } else if (game.blink_pending) {
+                // rearmado aqui: fora das telas de espera o tabuleiro para sozinho
+                game.blink_pending = 0;
+                game_display_checkerboard();
+                swtimer_start(&game.timer_blink, GAME_BLINK_MS, game_blink_timeout, NULL);
+            }
             break;
-        case 40:
-            // IMPROV: deuce
-            // player venceu game
-
-            // reseta pontos para proximo game
-            board->score[p_idx].points = 0;
-            board->score[(p_idx + 1) % 2].points = 0;
-
-            // atualiza numero de games
-            board->score[p_idx].games += 1;
-            board_update_LCD_games(board);
-
-            // verifica se player ganhou set
-            if (board->score[p_idx].games == games_to_set) {
-                // IMPROV: 2+ games diff
-                board->score[p_idx].games = 0;
-                board->score[(p_idx + 1) % 2].games = 0;
-                board->score[p_idx].sets += 1;
+        case PLAYER_TURN:
+        case LCD_UPDATE:
+            primask = util_irq_desativa();
+            snapshot = *game.board;
+            hit = latency_take(&t_edge);
+            util_irq_restaura(primask);
+            if (hit) {
+                latency_frame_begin(t_edge);
+            }
+            board_display(&snapshot);
+            if (hit) {
+                latency_frame_end(t_edge);
             }
             break;
         default:
             break;
     }
-    board_update_LCD_points(board);
+}
+
+/**
+ * @brief Tarefa de atualizacao do LCD: escreve o que foi pedido desde a ultima execucao
+ *
+ * Os pedidos so alteram o espelho da DDRAM; ao final, GPIO_LCD_atualiza() enfileira
+ * apenas as celulas que mudaram (uma troca de pontos custa poucos bytes), enviadas
+ * pelo PIT sem bloquear a tarefa
+ */
+static void game_lcd_task(void *arg) {
+    uint32_t t0;
+    (void)arg;
+
+    if (game.lcd_pending == 0) {
+        GPIO_LCD_atualiza();  // celulas adiadas por fila cheia, se houver
+        return;
+    }
+    t0 = prof_begin();
+    if (game.lcd_pending & LCD_INIT) {
+        board_init_LCD();
+    }
+    if (game.lcd_pending & LCD_GAMES) {
+        board_update_LCD_games(&game.lcd_games);
+    }
+    if (game.lcd_pending & LCD_POINTS) {
+        board_update_LCD_points(game.board);
+    }
+    if (game.lcd_pending & LCD_MARKER) {
+        board_update_LCD_marker(game.lcd_marker, game.lcd_marker_glyph);
+    }
+    if (game.lcd_pending & LCD_PROF) {
+        if (game.prof_page < PROF_N_PHASES) {
+            prof_display_LCD((prof_phase_t)game.prof_page);
+        } else if (game.prof_page == PROF_N_PHASES) {
+            clock_display_LCD();
+        } else {
+            GPIO_LCD_display_stats();
+        }
+        game.prof_page = (game.prof_page + 1) % GAME_PROF_PAGES;
+        game.prof_shown = 1;
+    }
+    GPIO_LCD_atualiza();
+    prof_end(PROF_LCD, t0);
+    game.lcd_pending = 0;
+}
+
+/**
+ * @brief Tarefa de audio: inicia o som de rebatida quando pedido
+ *
+ * O som eh encerrado por game.timer_sound apos GAME_HIT_SOUND_MS; uma nova
+ * rebatida antes disso reinicia o temporizador
+ */
+static void game_audio_task(void *arg) {
+    (void)arg;
+
+    if (game.sound_request) {
+        game.sound_request = 0;
+        game_sound_note();
+        swtimer_start(&game.timer_sound, GAME_HIT_SOUND_MS, game_sound_timeout, NULL);
+    }
+}
+
+void game_wake(void) {
+    sched_post(game.task_control);
+}
+
+state_t game_state(void) {
+    return (state_t)fsm_state(&game.fsm);
+}
+
+void game_get_stats(fsm_stats_t *stats) {
+    uint32_t primask = util_irq_desativa();
+    *stats = game.fsm.stats;
+    util_irq_restaura(primask);
+}
+
+void game_hit_sound(void) {
+    game.sound_request = 1;
+    sched_post(game.task_audio);
+}
+
+void game_loop(uint8_t sets_to_win, player_t ai_player) {
+    game.board = ISR_getBoard();
+    game.sets_to_win = sets_to_win;
+    game.ai_player = ai_player;
+    prng_seed(&game.rng, get_seed());
+    ai_init(&game.ai, game.ai_player, &ai_default_params, &game.rng);
+
+    game.task_control = sched_add(game_control_task, NULL, GAME_PRIO_CONTROL, 0, 0);
+    game.task_audio = sched_add(game_audio_task, NULL, GAME_PRIO_AUDIO, 0, 0);
+    game.task_lcd = sched_add(game_lcd_task, NULL, GAME_PRIO_LCD, GAME_LCD_PERIOD_US, 0);
+    game.task_render = sched_add(game_render_task, NULL, GAME_PRIO_RENDER, GAME_RENDER_PERIOD_US, 0);
+    fsm_init(&game.fsm, game_states, &game_table[0][0], GAME_N_STATES, GAME_N_EVENTS, INICIO);
+    sched_set_idle(power_idle);
+    sched_run();
+}
+
+void game_display_checkerboard(void) {
+    static uint8_t toggle = 0;
+    uint8_t i, j;
+    for (i = 0; i < SCREEN_WIDTH; i++) {
+        for (j = 0; j < SCREEN_HEIGHT; j++) {
+            // nao fazer nada na regiao de informacoes
+            if (i >= WAIT_SCREEN_INNER_RECT_XMIN && i < WAIT_SCREEN_INNER_RECT_XMAX && j >= WAIT_SCREEN_INNER_RECT_YMIN && j < WAIT_SCREEN_INNER_RECT_YMAX) {
+                continue;
+            }
+            // quadrados de 8x8
+            if ((i / 8 + j / 8) % 2 == toggle) {
+                I2C_OLED_setPixel(i, j);
+            } else {
+                I2C_OLED_clrPixel(i, j);
+            }
+        }
+    }
+    // inverte quadrados
+    toggle = (toggle + 1) % 2;
+
+    I2C_OLED_redisplay();
+}
+
+void board_update_score(board_t *board, player_t winner, uint8_t games_to_set) {
+    if (board_score_point(board, winner)) {
+        // player venceu game: LCD mostra os games antes de o set ser fechado
+        game.lcd_games = *board;
+        game.lcd_pending |= LCD_GAMES;
+        game.lcd_set_winner = board_score_set(board, games_to_set) ? winner : PLAYER_NONE;
+    }
+    game.lcd_pending |= LCD_POINTS;
 }
 
 void board_init_LCD() {
@@ -308,8 +658,8 @@ void board_init_LCD() {
         32, 32, 32, 32,
         32, 32, 32, 32,
         0};
-    GPIO_LCD_escreve_string(0x00, empty_LCD);
-    GPIO_LCD_escreve_string(0x40, empty_LCD);
+    GPIO_LCD_escreve_buffer(0x00, empty_LCD);
+    GPIO_LCD_escreve_buffer(0x40, empty_LCD);
     while (player != PLAYER_NONE) {
         line_offset = (player == PLAYER_1 ? 0x00 : 0x40);
         string[0] = 'P';
@@ -317,7 +667,7 @@ void board_init_LCD() {
         string[2] = ':';
         string[3] = ' ';
         string[4] = '\0';
-        GPIO_LCD_escreve_string(line_offset | 0x00, (uint8_t *)string);
+        GPIO_LCD_escreve_buffer(line_offset | 0x00, (uint8_t *)string);
         player = (player == PLAYER_1 ? PLAYER_2 : PLAYER_NONE);
     }
 }
@@ -331,9 +681,9 @@ void board_update_LCD_games(board_t *board) {
         p_idx = player - 1;
         line_offset = (player == PLAYER_1 ? 0x00 : 0x40);
         string[0] = '0' + board->score[p_idx].games;
-        string[1] = ' ';
+        string[1] = (player == game.lcd_set_winner ? LCD_GLIFO_SET : ' ');
         string[2] = '\0';
-        GPIO_LCD_escreve_string(line_offset | column_offset, (uint8_t *)string);
+        GPIO_LCD_escreve_buffer(line_offset | column_offset, (uint8_t *)string);
         player = (player == PLAYER_1 ? PLAYER_2 : PLAYER_NONE);
     }
 }
@@ -346,17 +696,45 @@ void board_update_LCD_points(board_t *board) {
     while (player != PLAYER_NONE) {
         p_idx = player - 1;
         line_offset = (player == PLAYER_1 ? 0x00 : 0x40);
-        string[0] = '0' + board->score[p_idx].points / 10;
-        string[1] = '0' + board->score[p_idx].points % 10;
+        if (board->score[p_idx].points == SCORE_AD) {
+            string[0] = ' ';
+            string[1] = LCD_GLIFO_AD;
+        } else {
+            string[0] = '0' + board->score[p_idx].points / 10;
+            string[1] = '0' + board->score[p_idx].points % 10;
+        }
         string[2] = '\0';
-        GPIO_LCD_escreve_string(line_offset | 0x0e, (uint8_t *)string);
+        GPIO_LCD_escreve_buffer(line_offset | 0x0e, (uint8_t *)string);
         player = (player == PLAYER_1 ? PLAYER_2 : PLAYER_NONE);
     }
 }
 
+void board_update_LCD_marker(player_t player, uint8_t glyph) {
+    uint8_t marker[2] = {' ', '\0'};
+
+    // coluna 3: espaco entre "P1:" e os games
+    marker[0] = (player == PLAYER_1 ? glyph : ' ');
+    GPIO_LCD_escreve_buffer(0x03, marker);
+    marker[0] = (player == PLAYER_2 ? glyph : ' ');
+    GPIO_LCD_escreve_buffer(0x43, marker);
+}
+
 void board_display(board_t *board) {
-    uint8_t i, j, x, y;
+    uint32_t t0;
+
+    t0 = prof_begin();
     I2C_OLED_clrScrBuf();
+    board_draw_court();
+    board_draw_ball(board->ball_pos.x, board->ball_pos.y);
+    prof_end(PROF_RASTER, t0);
+
+    t0 = prof_begin();
+    I2C_OLED_redisplay();
+    prof_end(PROF_OLED, t0);
+}
+
+void board_draw_court(void) {
+    uint8_t i, j;
     // floor
     for (i = 8; i < SCREEN_WIDTH - 8; i++) {
         for (j = FLOOR_LEVEL; j < FLOOR_LEVEL + FLOOR_HEIGHT; j++) {
@@ -369,20 +747,22 @@ void board_display(board_t *board) {
             I2C_OLED_setPixel(i, j);
         }
     }
-    // ball
-    if (board->ball_pos.x > 0 &&
-        board->ball_pos.x <= SCREEN_WIDTH &&
-        board->ball_pos.y > 0 &&
-        board->ball_pos.y <= SCREEN_HEIGHT) {
-        x = (uint8_t)roundf(board->ball_pos.x);
-        y = (uint8_t)roundf(board->ball_pos.y);
+}
+
+void board_draw_ball(float x_pos, float y_pos) {
+    uint8_t i, j, x, y;
+    if (x_pos > 0 &&
+        x_pos <= SCREEN_WIDTH &&
+        y_pos > 0 &&
+        y_pos <= SCREEN_HEIGHT) {
+        x = (uint8_t)roundf(x_pos);
+        y = (uint8_t)roundf(y_pos);
         for (i = x - 2; i < x + 3; i++) {
             for (j = y - 2 + ABS_DIFF(i, x); j < y + 3 - ABS_DIFF(i, x); j++) {
                 I2C_OLED_setPixel(i, j);
             }
         }
     }
-    I2C_OLED_redisplay();
 }
 
 void game_start_screen_display() {
@@ -0,0 +1,143 @@
+/**
+ * @file input.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Fila de eventos dos botoes (um produtor, um consumidor)
+ * @date 2026-10-19
+ */
+
+#include "input.h"
+
+#include <stdint.h>
+
+#include "game.h"
+#include "latency.h"
+#include "mcu.h"
+#include "swtimer.h"
+#include "util.h"
+
+// impede o compilador de reordenar acessos a memoria (nucleo unico: basta isso)
+#define INPUT_BARRIER() asm volatile("" : : : "memory")
+
+static struct {
+    input_event_t ev[INPUT_QUEUE_LEN];
+    volatile uint8_t head;  // proxima posicao livre (produtor)
+    volatile uint8_t tail;  // proximo evento (consumidor)
+    uint32_t dropped;       // escrito apenas pelo produtor
+} input;
+
+// filtro de repiques (escrito apenas pelo produtor)
+static const uint8_t input_pins[INPUT_N_PINS] = {4, 5, 12};
+static uint32_t input_lockout;  // INPUT_LOCKOUT_MS em ciclos do nucleo
+static struct {
+    uint32_t t_window;  // borda que abriu a janela atual
+    uint32_t rejected;  // bordas dentro da janela
+    uint8_t seen;       // 1: t_window valido
+    uint8_t pressed;    // ultimo estado aceito do botao
+    swtimer_t confirm;  // fim da janela: confirma o nivel do pino
+} input_pin[INPUT_N_PINS];
+
+/**
+ * @brief Indice de um pino em input_pins, ou INPUT_N_PINS se nao for um botao
+ */
+static uint8_t input_index(uint8_t pin) {
+    uint8_t i;
+    for (i = 0; i < INPUT_N_PINS && input_pins[i] != pin; i++) {
+    }
+    return i;
+}
+
+/**
+ * @brief Pressionamento aceito: enfileira e avisa o consumidor
+ */
+static uint8_t input_accept(uint8_t i, uint32_t t) {
+    uint8_t pin = input_pins[i];
+
+    input_pin[i].pressed = 1;
+    if (!input_push(pin, t)) {
+        return 0;
+    }
+    if (pin != 12) {
+        latency_edge();  // PTA4/PTA5: botoes de rebatida
+    }
+    game_wake();
+    return 1;
+}
+
+/**
+ * @brief Fim da janela de um pino: le o nivel ja estabilizado (contexto de SysTick_Handler)
+ *
+ * Recupera o pressionamento cuja primeira borda foi lida em 1 pela ISR: os
+ * repiques seguintes cairam na janela e nenhuma borda chega depois que o contato
+ * assenta. O evento leva o instante da borda que abriu a janela
+ */
+static void input_confirm(void *arg) {
+    uint8_t i = (uint8_t)(intptr_t)arg;
+    uint8_t low = !(GPIOA_PDIR & GPIO_PIN(input_pins[i]));
+
+    if (low && !input_pin[i].pressed) {
+        input_accept(i, input_pin[i].t_window);
+    }
+    input_pin[i].pressed = low;
+}
+
+void input_init(void) {
+    input_lockout = clock_get()->core / 1000 * INPUT_LOCKOUT_MS;
+}
+
+uint8_t input_edge(uint8_t pin, uint32_t t, uint8_t pressed) {
+    uint8_t i = input_index(pin);
+
+    if (i == INPUT_N_PINS) {
+        return 0;
+    }
+    if (input_pin[i].seen && t - input_pin[i].t_window < input_lockout) {
+        // repique: nao reinicia a janela, o nivel final eh lido em input_confirm()
+        input_pin[i].rejected++;
+        return 0;
+    }
+    input_pin[i].t_window = t;
+    input_pin[i].seen = 1;
+    swtimer_start(&input_pin[i].confirm, INPUT_LOCKOUT_MS, input_confirm, (void *)(intptr_t)i);
+    // pino em 0 com o botao solto: pressionamento imediato; o resto fica para o fim da janela
+    if (pressed && !input_pin[i].pressed) {
+        return input_accept(i, t);
+    }
+    return 0;
+}
+
+uint8_t input_push(uint8_t pin, uint32_t t) {
+    uint8_t head = input.head;
+
+    if ((uint8_t)(head - input.tail) >= INPUT_QUEUE_LEN) {
+        input.dropped++;
+        return 0;
+    }
+    input.ev[head % INPUT_QUEUE_LEN].t = t;
+    input.ev[head % INPUT_QUEUE_LEN].pin = pin;
+    INPUT_BARRIER();  // evento completo antes de publicar
+    input.head = head + 1;
+    return 1;
+}
+
+uint8_t input_pop(input_event_t *ev) {
+    uint8_t tail = input.tail;
+
+    if (tail == input.head) {
+        return 0;
+    }
+    INPUT_BARRIER();  // le o evento depois de ver head
+    *ev = input.ev[tail % INPUT_QUEUE_LEN];
+    INPUT_BARRIER();  // evento copiado antes de liberar a posicao
+    input.tail = tail + 1;
+    return 1;
+}
+
+uint32_t input_dropped(void) {
+    return input.dropped;
+}
+
+uint32_t input_rejected(uint8_t pin) {
+    uint8_t i = input_index(pin);
+    return i < INPUT_N_PINS ? input_pin[i].rejected : 0;
+}
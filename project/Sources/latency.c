@@ -0,0 +1,57 @@
+/**
+ * @file latency.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Medida de latencia do botao ate a tela
+ * @date 2026-10-19
+ */
+
+#include "latency.h"
+
+#include "mcu.h"
+#include "prof.h"
+#include "util.h"
+
+static uint32_t latency_t_hit;             // borda da rebatida aplicada e ainda nao desenhada
+static volatile uint8_t latency_pending;   // 1: latency_t_hit valido
+
+void latency_init(void) {
+#ifdef LATENCY_SCOPE
+    SIM_SCGC5 |= SIM_SCGC5_PORTE_MASK;
+    PORT_PCR_REG(PORTE_BASE_PTR, LATENCY_SCOPE_PIN) = PORT_PCR_MUX(0x1);  // GPIO
+    GPIOE_PCOR = GPIO_PIN(LATENCY_SCOPE_PIN);
+    GPIOE_PDDR |= GPIO_PIN(LATENCY_SCOPE_PIN);
+#endif
+}
+
+void latency_edge(void) {
+#ifdef LATENCY_SCOPE
+    GPIOE_PSOR = GPIO_PIN(LATENCY_SCOPE_PIN);
+#endif
+}
+
+void latency_hit(uint32_t t_edge) {
+    prof_end(PROF_LAT_HIT, t_edge);
+    latency_t_hit = t_edge;
+    latency_pending = 1;
+}
+
+uint8_t latency_take(uint32_t *t_edge) {
+    if (!latency_pending) {
+        return 0;
+    }
+    latency_pending = 0;
+    *t_edge = latency_t_hit;
+    return 1;
+}
+
+void latency_frame_begin(uint32_t t_edge) {
+    prof_end(PROF_LAT_FRAME, t_edge);
+}
+
+void latency_frame_end(uint32_t t_edge) {
+    prof_end(PROF_LAT_PHOTON, t_edge);
+#ifdef LATENCY_SCOPE
+    GPIOE_PCOR = GPIO_PIN(LATENCY_SCOPE_PIN);
+#endif
+}
@@ -6,12 +6,39 @@
  * @date 2024-06-15
  */
 
+#include "delay.h"
 #include "game.h"
 #include "mcu.h"
+#include "periph.h"
+#include "stress.h"
+
+// lado controlado pelo microcontrolador: -DAI_PLAYER=PLAYER_2 para jogar sozinho
+#ifndef AI_PLAYER
+#define AI_PLAYER PLAYER_NONE
+#endif
 
 int main(int argc, char const *argv[]) {
     config();
+#ifdef DELAY_SELFTEST
+    // -DDELAY_SELFTEST: mostra no LCD a precisao de delay_us() antes do jogo
+    delay_selftest_run();
+    delay_us(3000000);
+#endif
+#ifdef LCD_BENCH
+    // -DLCD_BENCH: mostra no LCD os ciclos por byte dos dois caminhos do barramento
+    GPIO_LCD_bench_run();
+    delay_us(3000000);
+#endif
+#ifdef PERIPH_BENCH
+    // -DPERIPH_BENCH: mostra no LCD os ciclos do I2C e do TPM com parametros em tempo de execucao e constantes
+    periph_bench_run();
+    delay_us(3000000);
+#endif
+#ifdef STRESS_MODE
+    // -DSTRESS_MODE: mede o maior numero de bolas sustentavel em vez de jogar
+    stress_run();
+#endif
     // IMPROV: ask user for game config
-    game_loop(2);
+    game_loop(2, AI_PLAYER);
     return 0;
 }
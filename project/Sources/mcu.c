@@ -8,15 +8,33 @@
 
 #include "mcu.h"
 
-void config(void) {
-    SIM_setaFLLPLL(0);  // MCGFLLCLK
+#include "delay.h"
+#include "input.h"
+#include "latency.h"
+#include "power.h"
+#include "prof.h"
+#include "util.h"
+
+static uint64_t time_base_us;      // tempo no ultimo rebase_time_us()
+static uint64_t time_base_cycles;  // SysTick_getCycles() no mesmo instante
+static uint32_t time_hz;           // frequencia do SysTick desde entao
 
-    // Define a frequencia do sinal do barramento
-    SIM_setaOUTDIV4(0b001);  // bus clock = 20971520/2 = 10485760
+void config(void) {
+    // Relogios do nucleo, barramento e TPM (clock.h); frequencias em clock_get()
+    clock_init(CLOCK_PROFILE);
 
     // Seta a fonte do sinal ERCLK32K em LPO 1kHz
     OSC_LPO1kHz();
 
+    // Base de tempo: SysTick com o relogio do nucleo
+    rebase_time_us(0);
+
+    // Atrasos (usados pelo LCD) e histogramas calibrados pela frequencia configurada acima
+    delay_init();
+    prof_init();
+    input_init();
+    latency_init();  // pino do osciloscopio com -DLATENCY_SCOPE
+
     // Inicializa conexao com LCD
     GPIO_LCD_ativa_con();
 
@@ -24,15 +42,24 @@ void config(void) {
     GPIO_LCD_init();
 
     // Inicializa botoes
-    GPIO_switches_init(
-        2  // prioridade = 3 (mais baixa)
-    );
+    // prioridade = 0: a ISR so enfileira (input.h), entao marca a borda sem esperar o passo da fisica
+    GPIO_switches_init(0);
 
-    // Inicializa o modulo RTC com fonte LPO
+    // Inicializa o modulo RTC com fonte LPO (usado por get_seed())
     RTClpo_init();
 
+    // Passo da fisica: PIT canal 0 abaixo dos botoes e acima de todo o trabalho de tela
+    // (canal ativado por game.c durante a partida)
+    PIT_init(1);  // prioridade = 1
+
+    // Fila de escrita do LCD: PIT canal 1 cronometra cada byte (GPIO_LCD_init() acima eh bloqueante)
+    GPIO_LCD_fila_init();
+
+    // Modo ocioso: VLPS permitido, LPTMR para acordar
+    power_init(3);  // prioridade = 3 (mais baixa)
+
     // Set I2C connection to SSD1306
-    I2C_initConSSD1306();
+    I2C_initConSSD1306(clock_get()->i2c_icr);
 
     // Initialize OLED (SSD1306)
     I2C_initOLED();
@@ -48,19 +75,52 @@ void config(void) {
                           0,          // DMA DISABLE
                           0,          // Counting Mode = ASCENDING
                           0b111       // log2(PS) => PS = 2^7 == 128
-    );                                // (16384*128)/20971520 = 0.1s
+    );                                // MOD reescrito a cada nota (game.c)
     TPM_CH_config_especifica(1,       // TPM1
                              1,       // CH1
                              0b1010,  // Mode = Edge-aligned PWM
                              0        // TPM1_C1V
     );
-    TPM_habilitaNVICIRQ(18, 3);  // TPM1
+    // som de rebatida: nota e duracao controladas pela tarefa de audio de game.c
+}
+
+void rebase_time_us(uint64_t now_us) {
+    uint32_t primask = util_irq_desativa();
+    time_base_us = now_us;
+    time_hz = clock_get()->core;
+    SysTick_init(time_hz / SYSTICK_HZ,
+                 0  // prioridade = 0 (mais alta)
+    );
+    time_base_cycles = SysTick_getCycles();
+    util_irq_restaura(primask);
 }
 
-void reset_time(void) {
-    RTClpo_setTime(0);
+uint64_t get_time_us(void) {
+    uint32_t primask = util_irq_desativa();
+    uint32_t hz = time_hz;
+    uint64_t base = time_base_us, cycles = SysTick_getCycles() - time_base_cycles, seconds;
+    util_irq_restaura(primask);
+
+    seconds = cycles / hz;
+    // separa os segundos para que a multiplicacao nao estoure 64 bits
+    return base + seconds * 1000000 + (cycles - seconds * hz) * 1000000 / hz;
 }
 
-uint32_t get_time(void) {
-    return ((RTC_TSR * 32768) + RTC_TPR);
+uint32_t get_seed(void) {
+#ifdef PRNG_SEED
+    return PRNG_SEED;
+#else
+    uint32_t seed = 0, count, tick, i;
+    // o LPO (RTC) e o FLL (nucleo) sao osciladores independentes: o numero de
+    // voltas do laco em cada periodo do LPO varia nos bits menos significativos
+    for (i = 0; i < SEED_LPO_TICKS; i++) {
+        tick = RTC_TPR;
+        count = 0;
+        while (RTC_TPR == tick) {
+            count++;
+        }
+        seed = (seed << 5 | seed >> 27) ^ count;
+    }
+    return seed;
+#endif
 }
@@ -0,0 +1,128 @@
+/**
+ * @file periph.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Comparacao dos drivers com parametros em tempo de execucao e em tempo de compilacao
+ * @date 2026-10-19
+ */
+
+#include "periph.h"
+
+#include "util.h"
+
+#define PERIPH_BENCH_I2C_N 32  // NOPs por transferencia ao OLED
+#define PERIPH_BENCH_TPM_N 64  // atualizacoes de MOD e CnV por caminho
+
+/**
+ * @brief Ciclos desde t0, descontado o custo da propria leitura do SysTick
+ */
+static uint32_t periph_bench_dt(uint32_t t0, uint32_t overhead) {
+    uint32_t dt = SysTick_getCycles32() - t0;
+    return dt > overhead ? dt - overhead : 0;
+}
+
+/**
+ * @brief Espera o fim do byte em andamento sem limpar IICIF (tempo de barramento, fora da medida)
+ */
+static void periph_bench_spin(void) {
+    uint32_t i = 1000000;
+
+    while (!(periph_i2c(OLED_I2C)->S & I2C_S_IICIF_MASK) && i) {
+        i--;
+    }
+}
+
+void periph_bench(periph_bench_t *out) {
+    uint8_t nops[PERIPH_BENCH_I2C_N + 1];
+    uint32_t primask, t0, i, overhead, runtime = 0, inline_cycles = 0;
+    uint16_t mod, cnv;
+
+    // custo de duas leituras seguidas do contador
+    primask = util_irq_desativa();
+    t0 = SysTick_getCycles32();
+    overhead = SysTick_getCycles32() - t0;
+    util_irq_restaura(primask);
+
+    // comandos em sequencia: o SSD1306 executa NOPs sem alterar a tela
+    nops[0] = SSD1306_COMMAND_CONTINUE;
+    for (i = 1; i <= PERIPH_BENCH_I2C_N; i++) {
+        nops[i] = SSD1306_NOP;
+    }
+    // mesmo laco de I2C_WriteMultData(), medindo so a escrita em D e a limpeza
+    // de IICIF em I2C_Wait(): periph_bench_spin() absorve o tempo de fio antes
+    I2C_Start(OLED_I2C);
+    I2C_WriteByte(OLED_I2C, (uint8_t)((SSD1306_I2C << 1) | I2C_WRITE));
+    I2C_Wait(OLED_I2C);
+    for (i = 0; i < sizeof(nops); i++) {
+        primask = util_irq_desativa();
+        t0 = SysTick_getCycles32();
+        I2C_WriteByte(OLED_I2C, nops[i]);
+        runtime += periph_bench_dt(t0, overhead);
+        util_irq_restaura(primask);
+        periph_bench_spin();
+        primask = util_irq_desativa();
+        t0 = SysTick_getCycles32();
+        I2C_Wait(OLED_I2C);
+        runtime += periph_bench_dt(t0, overhead);
+        util_irq_restaura(primask);
+    }
+    I2C_Stop(OLED_I2C);
+    I2C_WaitStop(OLED_I2C);
+
+    periph_i2c_start(OLED_I2C);
+    periph_i2c_write_byte(OLED_I2C, (uint8_t)((SSD1306_I2C << 1) | I2C_WRITE));
+    periph_i2c_wait(OLED_I2C);
+    for (i = 0; i < sizeof(nops); i++) {
+        primask = util_irq_desativa();
+        t0 = SysTick_getCycles32();
+        periph_i2c_write_byte(OLED_I2C, nops[i]);
+        inline_cycles += periph_bench_dt(t0, overhead);
+        util_irq_restaura(primask);
+        periph_bench_spin();
+        primask = util_irq_desativa();
+        t0 = SysTick_getCycles32();
+        periph_i2c_wait(OLED_I2C);
+        inline_cycles += periph_bench_dt(t0, overhead);
+        util_irq_restaura(primask);
+    }
+    periph_i2c_stop(OLED_I2C);
+    periph_i2c_wait_stop(OLED_I2C);
+
+    out->i2c_runtime = runtime / sizeof(nops);
+    out->i2c_const = inline_cycles / sizeof(nops);
+
+    // mesmos valores reescritos: a nota em andamento (ou o silencio) nao muda
+    runtime = inline_cycles = 0;
+    mod = (uint16_t)TPM1_MOD;
+    cnv = (uint16_t)TPM1_C1V;
+    for (i = 0; i < PERIPH_BENCH_TPM_N; i++) {
+        primask = util_irq_desativa();
+        t0 = SysTick_getCycles32();
+        TPM_setaMOD(SOUND_TPM, mod);
+        TPM_setaCnV(SOUND_TPM, SOUND_TPM_CH, cnv);
+        runtime += periph_bench_dt(t0, overhead);
+        t0 = SysTick_getCycles32();
+        periph_tpm_set_mod(SOUND_TPM, mod);
+        periph_tpm_set_cnv(SOUND_TPM, SOUND_TPM_CH, cnv);
+        inline_cycles += periph_bench_dt(t0, overhead);
+        util_irq_restaura(primask);
+    }
+    out->tpm_runtime = runtime / PERIPH_BENCH_TPM_N;
+    out->tpm_const = inline_cycles / PERIPH_BENCH_TPM_N;
+}
+
+void periph_bench_run(void) {
+    periph_bench_t result;
+    // ciclos pelo caminho atual > ciclos com parametros constantes
+    // "I2C   1234> 1234" e "TPM     56>   12"
+    char line_i2c[17] = "I2C       >     ";
+    char line_tpm[17] = "TPM       >     ";
+
+    periph_bench(&result);
+    util_formata(result.i2c_runtime, line_i2c + 5, 5);
+    util_formata(result.i2c_const, line_i2c + 11, 5);
+    util_formata(result.tpm_runtime, line_tpm + 5, 5);
+    util_formata(result.tpm_const, line_tpm + 11, 5);
+    GPIO_LCD_escreve_string(0x00, (uint8_t *)line_i2c);
+    GPIO_LCD_escreve_string(0x40, (uint8_t *)line_tpm);
+}
@@ -0,0 +1,144 @@
+/**
+ * @file power.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Modo ocioso de baixo consumo (WFI e VLPS)
+ * @date 2026-10-19
+ */
+
+#include "power.h"
+
+#include "mcu.h"
+#include "sched.h"
+#include "swtimer.h"
+#include "util.h"
+
+#define POWER_IRQ_PIT 22
+#define POWER_IRQ_LPTMR 28
+#define POWER_IRQ_PORTA 30
+
+static uint8_t power_deep;
+static power_stats_t stats;
+
+void power_init(uint8_t prioridade) {
+    SMC_PMPROT = SMC_PMPROT_AVLP_MASK;  // permite VLPR/VLPW/VLPS (escrita unica)
+
+    SIM_SCGC5 |= SIM_SCGC5_LPTMR_MASK;  // habilita sinal de relogio
+    LPTMR0_CSR = LPTMR_CSR_TCF_MASK;    // desativa e limpa flag
+    LPTMR0_PSR = LPTMR_PSR_PCS(0b01) |  // LPO 1 kHz: continua contando em VLPS
+                 LPTMR_PSR_PBYP_MASK;   // sem prescaler: 1 contagem por ms
+
+    /**
+     * Configura o modulo NVIC: habilita IRQ 28, limpa pendencias e seta prioridade
+     * registrador NVIC_IPR7 (Tabela 3-7/p. 54 do Manual)
+     */
+    NVIC_ISER = NVIC_ISER_SETENA(1 << POWER_IRQ_LPTMR);
+    NVIC_ICPR = NVIC_ICPR_CLRPEND(1 << POWER_IRQ_LPTMR);
+    NVIC_IPR7 = (NVIC_IPR7 & ~NVIC_IP_PRI_28_MASK) | NVIC_IP_PRI_28(prioridade << 6);
+}
+
+void power_set_deep(uint8_t deep) {
+    power_deep = deep;
+}
+
+/**
+ * @brief Registra o motivo do despertar e a latencia (interrupcoes ainda desabilitadas)
+ */
+static void power_wake_reason(void) {
+    uint32_t ispr = NVIC_ISPR, latency;
+    uint8_t ch;
+
+    if (SCB_ICSR & SCB_ICSR_PENDSTSET_MASK) {
+        stats.wake_systick++;
+        latency = SYST_RVR - SYST_CVR;  // ciclos desde a recarga do contador
+    } else if (ispr & (1 << POWER_IRQ_PIT)) {
+        stats.wake_pit++;
+        // contagem do canal que expirou (0: fisica; 1: fila do LCD) em ciclos do barramento
+        ch = (PIT_TFLG(0) & PIT_TFLG_TIF_MASK) ? 0 : 1;
+        latency = (PIT_LDVAL(ch) - PIT_CVAL(ch)) * (clock_get()->core / clock_get()->bus);
+    } else {
+        if (ispr & (1 << POWER_IRQ_PORTA)) {
+            stats.wake_porta++;
+        } else if (ispr & (1 << POWER_IRQ_LPTMR)) {
+            stats.wake_lptmr++;
+        } else {
+            stats.wake_other++;
+        }
+        return;  // instante do evento desconhecido
+    }
+    stats.last_latency = latency;
+    if (latency > stats.max_latency) {
+        stats.max_latency = latency;
+    }
+}
+
+/**
+ * @brief Dorme em VLPS por ate ms milissegundos (interrupcoes desabilitadas)
+ */
+static void power_vlps(uint32_t ms) {
+    uint32_t elapsed, i;
+
+    LPTMR0_CSR = LPTMR_CSR_TCF_MASK;  // zera o contador
+    LPTMR0_CMR = LPTMR_CMR_COMPARE(ms);
+    LPTMR0_CSR = LPTMR_CSR_TIE_MASK | LPTMR_CSR_TEN_MASK;
+
+    SMC_PMCTRL = (SMC_PMCTRL & ~SMC_PMCTRL_STOPM_MASK) | SMC_PMCTRL_STOPM(0b010);  // VLPS
+    (void)SMC_PMCTRL;  // garante a escrita antes do WFI
+    SCB_SCR |= SCB_SCR_SLEEPDEEP_MASK;
+    asm volatile("wfi");
+    SCB_SCR &= ~SCB_SCR_SLEEPDEEP_MASK;
+
+    power_wake_reason();
+    if (LPTMR0_CSR & LPTMR_CSR_TCF_MASK) {
+        elapsed = ms;
+    } else {
+        LPTMR0_CNR = 0;  // escrita captura o contador para leitura
+        elapsed = LPTMR0_CNR;
+    }
+    LPTMR0_CSR = LPTMR_CSR_TCF_MASK;  // desativa e limpa flag
+    NVIC_ICPR = NVIC_ICPR_CLRPEND(1 << POWER_IRQ_LPTMR);
+
+    stats.deep_sleeps++;
+    stats.us_asleep += (uint64_t)elapsed * 1000;
+    // SysTick parado em VLPS: repoe os ticks perdidos (base de tempo e roda de temporizadores)
+    for (i = 0; i < elapsed; i++) {
+        SysTick_tick();
+        swtimer_tick();
+    }
+}
+
+void power_idle(void) {
+    uint32_t primask = util_irq_desativa();
+    uint64_t now = get_time_us(), next = sched_next_release(), t0;
+    uint32_t ms;
+
+    if (next <= now) {
+        // tarefa liberada entre a busca do escalonador e aqui
+        util_irq_restaura(primask);
+        return;
+    }
+
+    ms = swtimer_next();
+    if (next != UINT64_MAX && (next - now) / 1000 < ms) {
+        ms = (uint32_t)((next - now) / 1000);
+    }
+    // o PIT para em VLPS: com bytes do LCD pendentes, dorme so em WFI
+    if (power_deep && ms >= POWER_DEEP_MIN_MS && GPIO_LCD_fila_vazia()) {
+        power_vlps(ms > LPTMR_CMR_COMPARE_MASK ? LPTMR_CMR_COMPARE_MASK : ms);
+    } else {
+        // com PRIMASK ativo o WFI acorda com a interrupcao pendente, mas a ISR so
+        // roda apos util_irq_restaura(): da tempo de registrar o motivo
+        t0 = get_time_us();
+        asm volatile("wfi");
+        power_wake_reason();
+        stats.sleeps++;
+        stats.us_asleep += get_time_us() - t0;
+    }
+    util_irq_restaura(primask);
+}
+
+void power_get_stats(power_stats_t *out) {
+    uint32_t primask = util_irq_desativa();
+    *out = stats;
+    util_irq_restaura(primask);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file prng.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Gerador de numeros pseudo-aleatorios (xorshift32 com saida multiplicada)
+ * @date 2026-10-19
+ */
+
+#include "prng.h"
+
+#define PRNG_DEFAULT_SEED 0x6D2B79F5u
+#define PRNG_OUT_MULT 0x9E3779BBu
+
+void prng_seed(prng_t *rng, uint32_t seed) {
+    // espalha os bits da semente: sementes proximas geram sequencias distintas
+    seed ^= seed >> 16;
+    seed *= 0x7FEB352Du;
+    seed ^= seed >> 15;
+    seed *= 0x846CA68Bu;
+    seed ^= seed >> 16;
+    // xorshift nunca sai do estado zero
+    rng->state = seed ? seed : PRNG_DEFAULT_SEED;
+}
+
+uint32_t prng_next(prng_t *rng) {
+    uint32_t x = rng->state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng->state = x;
+    return x * PRNG_OUT_MULT;
+}
+
+uint32_t prng_range(prng_t *rng, uint32_t n) {
+    // bits mais altos sao os de melhor qualidade
+    return (uint32_t)(((uint64_t)prng_next(rng) * n) >> 32);
+}
+
+float prng_float(prng_t *rng, float min, float max) {
+    // 24 bits: precisao do float
+    return min + (max - min) * (float)(prng_next(rng) >> 8) * (1.0f / 16777216.0f);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file prof.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Histogramas de tempo por fase do quadro
+ * @date 2026-10-19
+ */
+
+#include "prof.h"
+
+#include "mcu.h"
+#include "util.h"
+
+// us por ciclo do nucleo em ponto fixo Q16
+static uint32_t prof_q16;
+static prof_hist_t prof_hist[PROF_N_PHASES];
+
+static const char prof_names[PROF_N_PHASES][5] = {"FIS ", "PTO ", "IA  ", "RAST", "OLED", "LCD ", "LHIT", "LINI", "LFIM"};
+
+void prof_init(void) {
+    prof_q16 = (uint32_t)((1000000ULL << 16) / clock_get()->core);
+}
+
+uint32_t prof_begin(void) {
+    return SysTick_getCycles32();
+}
+
+void prof_end(prof_phase_t phase, uint32_t t0) {
+    prof_hist_t *h = &prof_hist[phase];
+    uint32_t us = (uint32_t)(((uint64_t)(SysTick_getCycles32() - t0) * prof_q16) >> 16);
+    uint32_t v = us;
+    uint8_t k = 0;
+
+    // log2 por deslocamentos (o Cortex-M0+ nao tem CLZ)
+    while (v > 1 && k < PROF_BUCKETS - 1) {
+        v >>= 1;
+        k++;
+    }
+    h->bucket[k]++;
+    h->count++;
+    h->total_us += us;
+    if (us > h->max_us) {
+        h->max_us = us;
+    }
+}
+
+void prof_get(prof_phase_t phase, prof_hist_t *hist) {
+    uint32_t primask;
+
+    // a fisica acumula de PIT_IRQHandler
+    primask = util_irq_desativa();
+    *hist = prof_hist[phase];
+    util_irq_restaura(primask);
+}
+
+uint32_t prof_percentile(const prof_hist_t *hist, uint16_t permil) {
+    uint32_t target, acc = 0;
+    uint8_t k;
+
+    if (hist->count == 0) {
+        return 0;
+    }
+    target = (uint32_t)(((uint64_t)hist->count * permil + 999) / 1000);
+    for (k = 0; k < PROF_BUCKETS - 1; k++) {
+        acc += hist->bucket[k];
+        if (acc >= target) {
+            return 2u << k;
+        }
+    }
+    // ultima faixa nao tem limite: usa o maximo
+    return hist->max_us;
+}
+
+void prof_reset(void) {
+    uint32_t primask;
+    uint8_t i, k;
+
+    primask = util_irq_desativa();
+    for (i = 0; i < PROF_N_PHASES; i++) {
+        prof_hist[i].count = 0;
+        prof_hist[i].max_us = 0;
+        prof_hist[i].total_us = 0;
+        for (k = 0; k < PROF_BUCKETS; k++) {
+            prof_hist[i].bucket[k] = 0;
+        }
+    }
+    util_irq_restaura(primask);
+}
+
+/**
+ * @brief Escreve v em "digits" posicoes de str, saturando em 99...9
+ */
+static void prof_formata(uint32_t v, char *str, uint8_t digits) {
+    uint32_t limit = 1;
+    uint8_t i;
+    for (i = 0; i < digits; i++) {
+        limit *= 10;
+    }
+    util_formata(v < limit ? v : limit - 1, str, digits);
+}
+
+void prof_display_LCD(prof_phase_t phase) {
+    prof_hist_t hist;
+    uint8_t i;
+    // "OLED 50<   65536" e "99<131072 M92160"
+    char line_p50[17] = "     50<        ";
+    char line_p99[17] = "99<       M     ";
+
+    prof_get(phase, &hist);
+    for (i = 0; i < 4; i++) {
+        line_p50[i] = prof_names[phase][i];
+    }
+    prof_formata(prof_percentile(&hist, 500), line_p50 + 8, 8);
+    prof_formata(prof_percentile(&hist, 990), line_p99 + 3, 6);
+    prof_formata(hist.max_us, line_p99 + 11, 5);
+    GPIO_LCD_escreve_buffer(0x00, (uint8_t *)line_p50);
+    GPIO_LCD_escreve_buffer(0x40, (uint8_t *)line_p99);
+}
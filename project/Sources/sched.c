@@ -0,0 +1,150 @@
+/**
+ * @file sched.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Escalonador cooperativo com tarefas periodicas e de disparo unico
+ * @date 2026-10-19
+ */
+
+#include "sched.h"
+
+#include <stddef.h>
+
+#include "mcu.h"
+
+typedef struct {
+    sched_fn_t fn;
+    void *arg;
+    uint32_t period;        // us, 0 = disparo unico
+    uint32_t deadline;      // us apos a liberacao
+    uint64_t release;       // proxima liberacao (us)
+    uint8_t priority;
+    uint8_t armed;          // release eh valido
+    volatile uint8_t posted;  // escrito por ISRs
+    sched_stats_t stats;
+} sched_task_t;
+
+static sched_task_t tasks[SCHED_MAX_TASKS];
+static uint8_t n_tasks;
+static void (*sched_idle)(void);
+
+int8_t sched_add(sched_fn_t fn, void *arg, uint8_t priority, uint32_t period_us, uint32_t deadline_us) {
+    sched_task_t *t;
+    if (n_tasks >= SCHED_MAX_TASKS) {
+        return SCHED_NONE;
+    }
+    t = &tasks[n_tasks];
+    t->fn = fn;
+    t->arg = arg;
+    t->priority = priority;
+    t->period = period_us;
+    t->deadline = deadline_us ? deadline_us : period_us;
+    t->posted = 0;
+    t->armed = period_us != 0;
+    t->release = get_time_us();
+    return n_tasks++;
+}
+
+void sched_start(int8_t id, uint32_t delay_us) {
+    tasks[id].release = get_time_us() + delay_us;
+    tasks[id].armed = 1;
+}
+
+void sched_stop(int8_t id) {
+    tasks[id].armed = 0;
+    tasks[id].posted = 0;
+}
+
+void sched_post(int8_t id) {
+    tasks[id].posted = 1;
+}
+
+void sched_set_period(int8_t id, uint32_t period_us) {
+    tasks[id].period = period_us;
+    tasks[id].deadline = period_us;
+}
+
+uint8_t sched_run_once(void) {
+    sched_task_t *t, *best = NULL;
+    uint64_t now = get_time_us(), start;
+    uint32_t late, exec;
+    uint8_t i;
+
+    for (i = 0; i < n_tasks; i++) {
+        t = &tasks[i];
+        if (!t->posted && !(t->armed && t->release <= now)) {
+            continue;
+        }
+        if (best == NULL || t->priority < best->priority ||
+            (t->priority == best->priority && t->release < best->release)) {
+            best = t;
+        }
+    }
+    if (best == NULL) {
+        return 0;
+    }
+
+    t = best;
+    if (t->posted) {
+        // liberada por evento: sem prazo a verificar
+        t->posted = 0;
+        late = 0;
+    } else {
+        late = (uint32_t)(now - t->release);
+        if (late > t->deadline) {
+            t->stats.misses++;
+        }
+        if (t->period) {
+            // proxima liberacao mantem a fase; periodos inteiros pulados contam como perdas
+            t->release += t->period;
+            while (t->release + t->period <= now) {
+                t->release += t->period;
+                t->stats.misses++;
+            }
+        } else {
+            t->armed = 0;
+        }
+    }
+    if (late > t->stats.max_late_us) {
+        t->stats.max_late_us = late;
+    }
+
+    start = get_time_us();
+    t->fn(t->arg);
+    exec = (uint32_t)(get_time_us() - start);
+    if (exec > t->stats.max_exec_us) {
+        t->stats.max_exec_us = exec;
+    }
+    t->stats.runs++;
+    return 1;
+}
+
+void sched_set_idle(void (*idle)(void)) {
+    sched_idle = idle;
+}
+
+uint64_t sched_next_release(void) {
+    uint64_t next = UINT64_MAX;
+    uint8_t i;
+    for (i = 0; i < n_tasks; i++) {
+        if (tasks[i].posted) {
+            return 0;
+        }
+        if (tasks[i].armed && tasks[i].release < next) {
+            next = tasks[i].release;
+        }
+    }
+    return next;
+}
+
+void sched_run(void) {
+    while (1) {
+        if (!sched_run_once() && sched_idle != NULL) {
+            sched_idle();
+        }
+    }
+}
+
+void sched_get_stats(int8_t id, sched_stats_t *stats) {
+    *stats = tasks[id].stats;
+}
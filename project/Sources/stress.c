@@ -0,0 +1,143 @@
+/**
+ * @file stress.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Modo de estresse com varias bolas
+ * @date 2026-10-19
+ */
+
+#include "stress.h"
+
+#include "game.h"
+#include "mcu.h"
+#include "prng.h"
+#include "util.h"
+
+// bolas em estrutura de vetores (board_batch_t)
+static float stress_x[STRESS_MAX_BALLS];
+static float stress_y[STRESS_MAX_BALLS];
+static float stress_vx[STRESS_MAX_BALLS];
+static float stress_vy[STRESS_MAX_BALLS];
+static uint8_t stress_bounces_left[STRESS_MAX_BALLS];
+static uint8_t stress_bounces_right[STRESS_MAX_BALLS];
+static uint8_t stress_region[STRESS_MAX_BALLS];
+
+static board_batch_t batch = {
+    .x = stress_x,
+    .y = stress_y,
+    .vx = stress_vx,
+    .vy = stress_vy,
+    .bounces_left = stress_bounces_left,
+    .bounces_right = stress_bounces_right,
+    .region = stress_region,
+    .n = 0,
+    .params = &board_default_params,
+};
+
+static prng_t rng;
+
+/**
+ * @brief Relanca a bola i do meio da quadra
+ */
+static void stress_launch(uint32_t i) {
+    board_t ball;
+    board_batch_get(&batch, i, &ball);
+    board_reset_ball(&ball, &rng);
+    // espalha as bolas na altura para que nao fiquem sobrepostas
+    ball.ball_pos.y = prng_float(&rng, 4, NET_TOP - 4);
+    ball.region = MIDDLE;
+    board_batch_set(&batch, i, &ball);
+}
+
+/**
+ * @brief Um quadro do modo de estresse
+ *
+ * @return numero de bolas que encerraram o ponto
+ */
+static uint32_t stress_frame(uint32_t dt) {
+    board_t ball;
+    uint32_t i, points = 0;
+
+    board_batch_update(&batch, dt);
+    I2C_OLED_clrScrBuf();
+    board_draw_court();
+    for (i = 0; i < batch.n; i++) {
+        board_batch_get(&batch, i, &ball);
+        if (board_check_winner_point(&ball) != PLAYER_NONE) {
+            // ponto encerrado para esta bola: relanca
+            stress_launch(i);
+            points++;
+        }
+        board_draw_ball(stress_x[i], stress_y[i]);
+    }
+    I2C_OLED_redisplay();
+    return points;
+}
+
+void stress_measure(uint32_t n, uint32_t frames, stress_result_t *result) {
+    uint64_t t0, t1, t2;
+    uint32_t i;
+
+    batch.n = n > STRESS_MAX_BALLS ? STRESS_MAX_BALLS : n;
+    for (i = 0; i < batch.n; i++) {
+        stress_launch(i);
+    }
+    result->n = batch.n;
+    result->frames = frames;
+    result->points = 0;
+
+    t0 = t1 = get_time_us();
+    for (i = 0; i < frames; i++) {
+        t2 = get_time_us();
+        result->points += stress_frame((uint32_t)(t2 - t1));
+        t1 = t2;
+    }
+    result->us = (uint32_t)(get_time_us() - t0);
+}
+
+void stress_run(void) {
+    stress_result_t result, best = {0, 0, 0, 0};
+    uint32_t lo = 0, hi = STRESS_MAX_BALLS + 1, n, fps10;
+    uint64_t t1, t2;
+    char line_n[17] = "N:              ";
+    char line_max[17] = "N max:          ";
+    char line_fps[17] = "fps:            ";
+
+    prng_seed(&rng, get_seed());
+
+    // dobra n ate a primeira falha (ou ate o maximo), depois busca binaria em (lo, hi)
+    while (hi - lo > 1) {
+        n = hi > STRESS_MAX_BALLS ? (lo ? 2 * lo : 1) : (lo + hi) / 2;
+        if (n > STRESS_MAX_BALLS) {
+            n = STRESS_MAX_BALLS;
+        }
+        util_formata(n, line_n + 3, 4);
+        GPIO_LCD_escreve_string(0x00, (uint8_t *)line_n);
+
+        stress_measure(n, STRESS_FRAMES, &result);
+        if (result.us * STRESS_TARGET_FPS <= result.frames * 1000000) {
+            lo = n;
+            best = result;
+        } else {
+            hi = n;
+        }
+    }
+
+    // "N max:  128" e "fps:  9.8" (decimos de quadro por segundo)
+    util_formata(best.n, line_max + 7, 4);
+    GPIO_LCD_escreve_string(0x00, (uint8_t *)line_max);
+    fps10 = best.us ? (uint32_t)((uint64_t)best.frames * 10000000 / best.us) : 0;
+    util_formata(fps10 / 10, line_fps + 5, 3);
+    line_fps[8] = '.';
+    line_fps[9] = '0' + fps10 % 10;
+    GPIO_LCD_escreve_string(0x40, (uint8_t *)line_fps);
+
+    // continua animando com o maior n sustentavel
+    stress_measure(best.n, 0, &result);
+    t1 = get_time_us();
+    while (1) {
+        t2 = get_time_us();
+        stress_frame((uint32_t)(t2 - t1));
+        t1 = t2;
+    }
+}
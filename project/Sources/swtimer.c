@@ -0,0 +1,120 @@
+/**
+ * @file swtimer.c
+ * @author Gustavo Nascimento Soares
+ * @author João Pedro Souza Pascon
+ * @brief Temporizadores de software em roda de tempo
+ * @date 2026-10-19
+ */
+
+#include "swtimer.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sched.h"
+#include "util.h"
+
+// swtimer_t.active
+#define SWTIMER_IDLE 0
+#define SWTIMER_WHEEL 1    // na roda
+#define SWTIMER_EXPIRED 2  // expirado, aguardando a chamada da funcao em swtimer_tick()
+
+static swtimer_t *wheel[SWTIMER_SLOTS];
+static swtimer_t *expired;     //!< expirados no tick atual, ainda nao chamados
+static volatile uint32_t now;  //!< ticks desde o inicio
+
+static void swtimer_unlink(swtimer_t *timer) {
+    if (timer->prev != NULL) {
+        timer->prev->next = timer->next;
+    } else if (timer->active == SWTIMER_EXPIRED) {
+        expired = timer->next;
+    } else {
+        wheel[timer->expires & (SWTIMER_SLOTS - 1)] = timer->next;
+    }
+    if (timer->next != NULL) {
+        timer->next->prev = timer->prev;
+    }
+    timer->active = SWTIMER_IDLE;
+}
+
+static void swtimer_push(swtimer_t **head, swtimer_t *timer) {
+    timer->prev = NULL;
+    timer->next = *head;
+    if (*head != NULL) {
+        (*head)->prev = timer;
+    }
+    *head = timer;
+}
+
+static void swtimer_post(void *arg) {
+    sched_post((int8_t)(intptr_t)arg);
+}
+
+void swtimer_start(swtimer_t *timer, uint32_t delay_ms, swtimer_fn_t fn, void *arg) {
+    uint32_t primask = util_irq_desativa();
+
+    if (timer->active != SWTIMER_IDLE) {
+        swtimer_unlink(timer);
+    }
+    timer->fn = fn;
+    timer->arg = arg;
+    timer->expires = now + (delay_ms ? delay_ms : 1);
+    // insere no inicio da lista da posicao
+    swtimer_push(&wheel[timer->expires & (SWTIMER_SLOTS - 1)], timer);
+    timer->active = SWTIMER_WHEEL;
+
+    util_irq_restaura(primask);
+}
+
+void swtimer_start_post(swtimer_t *timer, uint32_t delay_ms, int8_t task) {
+    swtimer_start(timer, delay_ms, swtimer_post, (void *)(intptr_t)task);
+}
+
+void swtimer_cancel(swtimer_t *timer) {
+    uint32_t primask = util_irq_desativa();
+    if (timer->active != SWTIMER_IDLE) {
+        swtimer_unlink(timer);
+    }
+    util_irq_restaura(primask);
+}
+
+uint8_t swtimer_active(const swtimer_t *timer) {
+    return timer->active != SWTIMER_IDLE;
+}
+
+uint32_t swtimer_next(void) {
+    swtimer_t *timer;
+    uint32_t next = UINT32_MAX;
+    uint8_t i;
+    for (i = 0; i < SWTIMER_SLOTS; i++) {
+        for (timer = wheel[i]; timer != NULL; timer = timer->next) {
+            if (timer->expires - now < next) {
+                next = timer->expires - now;
+            }
+        }
+    }
+    return next;
+}
+
+void swtimer_tick(void) {
+    swtimer_t *timer, *next;
+
+    now++;
+    // separa os expirados antes de chamar qualquer funcao; temporizadores com
+    // atraso >= SWTIMER_SLOTS ficam na lista ate a volta certa
+    for (timer = wheel[now & (SWTIMER_SLOTS - 1)]; timer != NULL; timer = next) {
+        next = timer->next;
+        if (timer->expires == now) {
+            swtimer_unlink(timer);
+            swtimer_push(&expired, timer);
+            timer->active = SWTIMER_EXPIRED;
+        }
+    }
+    // a lista eh relida a cada chamada: a funcao pode cancelar ou reiniciar
+    // qualquer temporizador, inclusive o proprio ou um expirado ainda nao chamado
+    while (expired != NULL) {
+        timer = expired;
+        swtimer_unlink(timer);
+        timer->fn(timer->arg);
+    }
+}
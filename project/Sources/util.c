@@ -6,56 +6,14 @@
  * @author João Pedro Souza Pascon
  */
 
-#include <stdint.h>
+#include "util.h"
 
-void espera_2us(uint32_t n) __attribute__((naked));
-void espera_2us(uint32_t n) {
-    asm volatile(
-        "cmp r0, #0 \n\t"
-        "beq espera_ret \n\t"
-        "espera_loop: \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "add r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "sub r0, #1 \n\t"
-        "cmp r0, #0 \n\t"
-        "bne espera_loop \n\t"
-        "espera_ret: \n\t"
-        "bx lr"
-        :
-        :
-        :);
+void util_formata(uint32_t v, char *str, uint8_t digits) {
+    do {
+        str[--digits] = '0' + v % 10;
+        v /= 10;
+    } while (v && digits);
+    while (digits) {
+        str[--digits] = ' ';
+    }
 }